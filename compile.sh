@@ -17,7 +17,7 @@ if [ "$#" -ne 0 ]; then
 fi
 
 # COMPILE
-error=$(gcc -fopenmp -o PiDecimals.x sources/common/*.c sources/gmp/*.c sources/gmp/algorithms/*.c sources/mpfr/*.c sources/mpfr/algorithms/*.c -lmpfr -lgmp -lm 2>&1 1>/dev/null)
+error=$(gcc -fopenmp -o PiDecimals.x sources/common/*.c sources/gmp/*.c sources/gmp/algorithms/*.c sources/mpfr/*.c sources/mpfr/algorithms/*.c sources/decimal/*.c sources/decimal/algorithms/*.c -lmpfr -lgmp -lm 2>&1 1>/dev/null)
 
 
 # GIVE FEEDBACK ABOUT COMPILATION
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <limits.h>
+#include "bench.h"
+#include "printer.h"
+
+
+#define BENCH_MAX_VALUES 64             // Values of each list (algorithms, precisions, threads)
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Benchmark harness: repetitions, warmup and thread sweeps in one process (-bench) *
+ *                                                                                  *
+ ************************************************************************************
+ * Every combination of the lists of algorithms, precisions and threads is run      *
+ * warmup times (discarded) and then repetitions times, calling the engine of the   *
+ * library in the same process. The execution time is taken by the engine with a    *
+ * monotonic clock, from the initialization of pi to the end of the algorithm (the  *
+ * check of the decimals is left out), and it is passed here with bench_record.     *
+ *                                                                                  *
+ * For each combination the min, the median, the 95th percentile (nearest rank),    *
+ * the mean and the standard deviation are shown, with the scaling against the      *
+ * first thread count of the list (T0):                                             *
+ *                                                                                  *
+ *      strong: same precision,   speedup = median(T0) / median(T),                 *
+ *                                efficiency = speedup * T0 / T                     *
+ *      weak (-weak): precision * T / T0,   efficiency = median(T0) / median(T),    *
+ *                                speedup = efficiency * T / T0 (scaled)            *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int bench_running = 0;
+static char * bench_algorithm_tag = NULL;
+static double bench_execution_time = 0;
+static long bench_decimals = 0;
+
+
+/*
+ * Seconds of a monotonic clock (it does not jump with the changes of the time of the system)
+ */
+double bench_clock(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1.e9;
+}
+
+int bench_is_running(){
+    return bench_running;
+}
+
+/*
+ * Called by the engines at the end of each execution instead of printing the results
+ */
+void bench_record(char * algorithm_tag, double execution_time, long decimals_computed){
+    bench_algorithm_tag = algorithm_tag;
+    bench_execution_time = execution_time;
+    bench_decimals = decimals_computed;
+}
+
+/*
+ * Parses a list of positive numbers separated by commas (5,7 or 1,2,4,8)
+ */
+static int bench_parse_list(char * text, long * values, char * name){
+    char * end;
+    int num_values = 0;
+
+    while(num_values < BENCH_MAX_VALUES){
+        values[num_values] = strtol(text, &end, 10);
+        if(end == text || values[num_values] < 0 || (*end != ',' && *end != '\0')){
+            printf("  The list of %s should be numbers separated by commas (for example 1,2,4). \n\n", name);
+            exit(-1);
+        }
+        num_values++;
+        if(*end == '\0') return num_values;
+        text = end + 1;
+    }
+    printf("  The list of %s can not have more than %d values. \n\n", name, BENCH_MAX_VALUES);
+    exit(-1);
+}
+
+static int bench_compare(const void * a, const void * b){
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * Statistics of num_samples samples (sorted in place)
+ */
+static void bench_statistics_of(double * samples, int num_samples, bench_statistics * statistics){
+    double sum = 0, squares = 0;
+    int i;
+
+    qsort(samples, num_samples, sizeof(double), bench_compare);
+    for(i = 0; i < num_samples; i++){
+        sum += samples[i];
+    }
+    statistics -> mean = sum / num_samples;
+    for(i = 0; i < num_samples; i++){
+        squares += (samples[i] - statistics -> mean) * (samples[i] - statistics -> mean);
+    }
+    statistics -> stddev = (num_samples > 1) ? sqrt(squares / (num_samples - 1)) : 0;
+    statistics -> min = samples[0];
+    statistics -> median = (num_samples % 2 == 1) ? samples[num_samples / 2] : (samples[num_samples / 2 - 1] + samples[num_samples / 2]) / 2;
+    statistics -> p95 = samples[(int) ceil(0.95 * num_samples) - 1];
+}
+
+/*
+ * Runs every combination of the lists with calculate (the engine of the library)
+ */
+void bench_run(char * library, void (*calculate)(int, long, int, bool), char * algorithm_list, char * precision_list,
+               char * thread_list, int repetitions, int warmup, bool weak_scaling, bool print_in_csv_format){
+    long algorithms[BENCH_MAX_VALUES], precisions[BENCH_MAX_VALUES], threads[BENCH_MAX_VALUES];
+    int num_algorithms, num_precisions, num_threads, a, p, t, i;
+    long precision, min_decimals;
+    double * samples, baseline = 0, speedup, efficiency;
+    bench_statistics statistics;
+
+    num_algorithms = bench_parse_list(algorithm_list, algorithms, "algorithms");
+    num_precisions = bench_parse_list(precision_list, precisions, "precisions");
+    num_threads = bench_parse_list(thread_list, threads, "threads");
+    for(t = 0; t < num_threads; t++){
+        if(threads[t] <= 0){
+            printf("  The number of threads should be greater than cero. \n\n");
+            exit(-1);
+        }
+    }
+    samples = malloc(repetitions * sizeof(double));
+    if(samples == NULL){
+        printf("Not enough memory for the samples \n");
+        exit(-1);
+    }
+
+    bench_running = 1;
+    if (!print_in_csv_format) {
+        print_bench_header(repetitions, warmup, weak_scaling);
+    }
+    for(a = 0; a < num_algorithms; a++){
+        for(p = 0; p < num_precisions; p++){
+            for(t = 0; t < num_threads; t++){
+                precision = (weak_scaling) ? precisions[p] * threads[t] / threads[0] : precisions[p];
+                for(i = 0; i < warmup; i++){
+                    calculate(algorithms[a], precision, threads[t], print_in_csv_format);
+                }
+                min_decimals = LONG_MAX;
+                for(i = 0; i < repetitions; i++){
+                    calculate(algorithms[a], precision, threads[t], print_in_csv_format);
+                    samples[i] = bench_execution_time;
+                    if(bench_decimals < min_decimals) min_decimals = bench_decimals;
+                }
+                bench_statistics_of(samples, repetitions, &statistics);
+
+                //Scaling against the first thread count
+                if(t == 0) baseline = statistics.median;
+                if(weak_scaling){
+                    efficiency = (statistics.median > 0) ? baseline / statistics.median : 0;
+                    speedup = efficiency * threads[t] / threads[0];         // Scaled speedup
+                } else {
+                    speedup = (statistics.median > 0) ? baseline / statistics.median : 0;
+                    efficiency = speedup * threads[0] / threads[t];
+                }
+                if (print_in_csv_format) {
+                    print_bench_row_csv(library, bench_algorithm_tag, precision, threads[t], repetitions, statistics.min, statistics.median,
+                                        statistics.p95, statistics.mean, statistics.stddev, speedup, efficiency, min_decimals);
+                } else {
+                    print_bench_row(bench_algorithm_tag, precision, threads[t], statistics.min, statistics.median,
+                                    statistics.p95, statistics.stddev, speedup, efficiency, min_decimals);
+                }
+            }
+        }
+    }
+    if (!print_in_csv_format) {
+        printf("\n");
+    }
+    bench_running = 0;
+    free(samples);
+}
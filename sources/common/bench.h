@@ -0,0 +1,19 @@
+#ifndef BENCH
+#define BENCH
+
+#include <stdbool.h>
+
+typedef struct {
+    double min;
+    double median;
+    double p95;
+    double mean;
+    double stddev;
+} bench_statistics;
+
+double bench_clock();
+int bench_is_running();
+void bench_record(char *, double, long);
+void bench_run(char *, void (*)(int, long, int, bool), char *, char *, char *, int, int, bool, bool);
+
+#endif
@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "checkpoint.h"
+
+
+#define CHECKPOINT_MAGIC "PICKPT01"
+#define CHECKPOINT_DEFAULT_INTERVAL 600 // Seconds between the checkpoints of a thread
+#define CHECKPOINT_FNV_OFFSET 14695981039346656037UL
+#define CHECKPOINT_FNV_PRIME 1099511628211UL
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Checkpoints of the block engines (-checkpoint DIR) and restart (-resume)         *
+ *                                                                                  *
+ ************************************************************************************
+ * The blocks of the threads are independent, so the state of a thread (its         *
+ * local_pi, its dependencies and the next iteration of its block) is a consistent  *
+ * checkpoint by itself, whatever the other threads are doing. The directory has:   *
+ *                                                                                  *
+ *      manifest        algorithm, precision, iterations and threads of the run     *
+ *      thread_T.state  last checkpoint of the thread T                             *
+ *                                                                                  *
+ * Every interval seconds (600 by default, -checkpoint-every) each thread copies    *
+ * its values to its buffer (gmp/checkpoint.c, mpfr/checkpoint.c) and goes on: a    *
+ * writer thread writes the buffer to thread_T.tmp, syncs it and renames it to      *
+ * thread_T.state, so the last complete checkpoint is never lost. If the previous   *
+ * checkpoint of a thread is still being written the thread does not wait, it       *
+ * tries again in the next iteration. Each file has a checksum of its values.       *
+ *                                                                                  *
+ * With -resume the manifest must match the execution and each thread starts from   *
+ * its checkpoint (or from the start of its block if it has none). The directory    *
+ * is emptied when the series ends                                                  *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    char * buffer;                      // Values of the thread (owned by the writer while pending)
+    size_t capacity;
+    size_t bytes;
+    long index;                         // Next iteration of the thread
+    int pending;                        // Waiting for the writer
+    double last_time;                   // Time of the last checkpoint
+} checkpoint_slot;
+
+static char * checkpoint_directory = NULL;
+static long checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+static int checkpoint_resume = 0;
+static int checkpoint_active = 0;
+static int checkpoint_num_threads = 0;
+static checkpoint_slot * slots = NULL;
+static pthread_t writer;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static int stopping = 0;
+static unsigned long checkpoints_written = 0;
+static unsigned long bytes_written = 0;
+static double write_time = 0;
+static int threads_resumed = 0;
+
+
+void checkpoint_enable(char * directory){
+    checkpoint_directory = directory;
+}
+
+void checkpoint_set_interval(long seconds){
+    checkpoint_interval = seconds;
+}
+
+void checkpoint_set_resume(){
+    checkpoint_resume = 1;
+}
+
+int checkpoint_is_enabled(){
+    return checkpoint_directory != NULL;
+}
+
+int checkpoint_is_resuming(){
+    return checkpoint_resume;
+}
+
+int checkpoint_is_active(){
+    return checkpoint_active;
+}
+
+static double checkpoint_now(){
+    struct timeval t;
+
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec / 1.e6;
+}
+
+static void checkpoint_path(char * path, size_t bytes, char * name, int thread_id){
+    if(thread_id < 0) snprintf(path, bytes, "%s/%s", checkpoint_directory, name);
+    else snprintf(path, bytes, "%s/thread_%d.%s", checkpoint_directory, thread_id, name);
+}
+
+static uint64_t checkpoint_checksum(const char * data, size_t bytes){
+    uint64_t checksum = CHECKPOINT_FNV_OFFSET;
+    size_t i;
+
+    for(i = 0; i < bytes; i++){
+        checksum ^= (unsigned char) data[i];
+        checksum *= CHECKPOINT_FNV_PRIME;
+    }
+    return checksum;
+}
+
+static void checkpoint_io_error(char * path){
+    printf("  The checkpoint %s can not be written \n\n", path);
+    exit(-1);
+}
+
+/*
+ * Writes bytes bytes of data in fd
+ */
+static void checkpoint_write_all(int fd, const void * data, size_t bytes, char * path){
+    size_t done = 0;
+    ssize_t written;
+
+    while(done < bytes){
+        written = write(fd, (const char *) data + done, bytes - done);
+        if(written <= 0) checkpoint_io_error(path);
+        done += written;
+    }
+}
+
+/*
+ * Writes the checkpoint of thread_id (tmp file, sync and rename)
+ */
+static void checkpoint_write_slot(int thread_id){
+    checkpoint_slot * slot = &slots[thread_id];
+    char tmp_path[4096], path[4096];
+    uint64_t bytes = slot -> bytes, checksum;
+    double t1 = checkpoint_now();
+    int fd;
+
+    checkpoint_path(tmp_path, sizeof(tmp_path), "tmp", thread_id);
+    checkpoint_path(path, sizeof(path), "state", thread_id);
+    checksum = checkpoint_checksum(slot -> buffer, slot -> bytes);
+    fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) checkpoint_io_error(tmp_path);
+    checkpoint_write_all(fd, CHECKPOINT_MAGIC, 8, tmp_path);
+    checkpoint_write_all(fd, &slot -> index, sizeof(long), tmp_path);
+    checkpoint_write_all(fd, &bytes, sizeof(uint64_t), tmp_path);
+    checkpoint_write_all(fd, &checksum, sizeof(uint64_t), tmp_path);
+    checkpoint_write_all(fd, slot -> buffer, slot -> bytes, tmp_path);
+    if(fsync(fd) != 0 || close(fd) != 0 || rename(tmp_path, path) != 0) checkpoint_io_error(path);
+
+    checkpoints_written++;
+    bytes_written += slot -> bytes;
+    write_time += checkpoint_now() - t1;
+}
+
+/*
+ * Writer thread: writes the pending checkpoints while the threads compute
+ */
+static void * checkpoint_writer(void * unused){
+    int thread_id;
+
+    pthread_mutex_lock(&lock);
+    while(!stopping){
+        for(thread_id = 0; thread_id < checkpoint_num_threads && !slots[thread_id].pending; thread_id++);
+        if(thread_id == checkpoint_num_threads){
+            pthread_cond_wait(&wake, &lock);
+            continue;
+        }
+        pthread_mutex_unlock(&lock);
+        checkpoint_write_slot(thread_id);
+        pthread_mutex_lock(&lock);
+        slots[thread_id].pending = 0;
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+/*
+ * Writes the manifest of the execution or, with -resume, checks that it matches
+ */
+static void checkpoint_manifest(char * algorithm_tag, long precision, long num_iterations, int num_threads){
+    char path[4096], tmp_path[4096], saved_tag[64];
+    long saved_precision, saved_iterations;
+    int saved_threads, thread_id;
+    FILE * file;
+
+    checkpoint_path(path, sizeof(path), "manifest", -1);
+    if(checkpoint_resume){
+        file = fopen(path, "r");
+        if(file == NULL){
+            printf("  There is no checkpoint to resume in %s \n\n", checkpoint_directory);
+            exit(-1);
+        }
+        if(fscanf(file, "algorithm %63s precision %ld iterations %ld threads %d", saved_tag, &saved_precision, &saved_iterations, &saved_threads) != 4
+           || strcmp(saved_tag, algorithm_tag) != 0 || saved_precision != precision || saved_iterations != num_iterations || saved_threads != num_threads){
+            printf("  The checkpoint in %s is not of this execution (%s, %ld decimals, %d threads) \n\n", checkpoint_directory, algorithm_tag, precision, num_threads);
+            exit(-1);
+        }
+        fclose(file);
+        return;
+    }
+
+    //A new execution: the checkpoints of the previous one are removed
+    for(thread_id = 0; thread_id < num_threads; thread_id++){
+        checkpoint_path(tmp_path, sizeof(tmp_path), "state", thread_id);
+        unlink(tmp_path);
+    }
+    checkpoint_path(tmp_path, sizeof(tmp_path), "manifest.tmp", -1);
+    file = fopen(tmp_path, "w");
+    if(file == NULL) checkpoint_io_error(tmp_path);
+    fprintf(file, "algorithm %s\nprecision %ld\niterations %ld\nthreads %d\n", algorithm_tag, precision, num_iterations, num_threads);
+    if(fclose(file) != 0 || rename(tmp_path, path) != 0) checkpoint_io_error(path);
+}
+
+/*
+ * Starts the checkpoints of an execution and the writer thread
+ */
+void checkpoint_begin(char * algorithm_tag, long precision, long num_iterations, int num_threads){
+    double now = checkpoint_now();
+    int thread_id;
+
+    if(!checkpoint_is_enabled()) return;
+    checkpoint_manifest(algorithm_tag, precision, num_iterations, num_threads);
+
+    checkpoint_num_threads = num_threads;
+    slots = calloc(num_threads, sizeof(checkpoint_slot));
+    if(slots == NULL){
+        printf("Not enough memory for the checkpoints \n");
+        exit(-1);
+    }
+    for(thread_id = 0; thread_id < num_threads; thread_id++){
+        slots[thread_id].last_time = now;
+    }
+    stopping = 0;
+    if(pthread_create(&writer, NULL, checkpoint_writer, NULL) != 0){
+        printf("  The checkpoint writer can not be started \n\n");
+        exit(-1);
+    }
+    checkpoint_active = 1;
+}
+
+/*
+ * True if thread_id should take a checkpoint
+ */
+int checkpoint_due(int thread_id){
+    return checkpoint_active && checkpoint_now() - slots[thread_id].last_time >= checkpoint_interval;
+}
+
+/*
+ * Buffer of bytes bytes for the next checkpoint of thread_id, or NULL if its
+ * previous checkpoint is still being written (the thread does not wait)
+ */
+char * checkpoint_buffer(int thread_id, size_t bytes){
+    checkpoint_slot * slot = &slots[thread_id];
+    int pending;
+
+    pthread_mutex_lock(&lock);
+    pending = slot -> pending;
+    pthread_mutex_unlock(&lock);
+    if(pending) return NULL;
+
+    if(slot -> capacity < bytes){
+        free(slot -> buffer);
+        slot -> buffer = malloc(bytes);
+        if(slot -> buffer == NULL){
+            printf("Not enough memory for the checkpoints \n");
+            exit(-1);
+        }
+        slot -> capacity = bytes;
+    }
+    return slot -> buffer;
+}
+
+/*
+ * Hands the buffer of thread_id (bytes bytes, state before the iteration index) to the writer
+ */
+void checkpoint_submit(int thread_id, long index, size_t bytes){
+    checkpoint_slot * slot = &slots[thread_id];
+
+    slot -> index = index;
+    slot -> bytes = bytes;
+    slot -> last_time = checkpoint_now();
+    pthread_mutex_lock(&lock);
+    slot -> pending = 1;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+ * Reads the checkpoint of thread_id (with -resume). Returns its values (to be freed)
+ * and its next iteration in index, or NULL if the thread has no checkpoint
+ */
+char * checkpoint_load(int thread_id, long * index, size_t * bytes){
+    char path[4096], magic[8];
+    uint64_t saved_bytes, checksum;
+    char * buffer;
+    FILE * file;
+
+    if(!checkpoint_active || !checkpoint_resume) return NULL;
+    checkpoint_path(path, sizeof(path), "state", thread_id);
+    file = fopen(path, "r");
+    if(file == NULL) return NULL;
+
+    if(fread(magic, 8, 1, file) != 1 || memcmp(magic, CHECKPOINT_MAGIC, 8) != 0 || fread(index, sizeof(long), 1, file) != 1
+       || fread(&saved_bytes, sizeof(uint64_t), 1, file) != 1 || fread(&checksum, sizeof(uint64_t), 1, file) != 1){
+        printf("  The checkpoint %s is corrupted \n\n", path);
+        exit(-1);
+    }
+    buffer = malloc(saved_bytes);
+    if(buffer == NULL){
+        printf("Not enough memory for the checkpoints \n");
+        exit(-1);
+    }
+    if(fread(buffer, 1, saved_bytes, file) != saved_bytes || checkpoint_checksum(buffer, saved_bytes) != checksum){
+        printf("  The checkpoint %s is corrupted \n\n", path);
+        exit(-1);
+    }
+    fclose(file);
+
+    *bytes = saved_bytes;
+    #pragma omp atomic
+    threads_resumed++;
+    return buffer;
+}
+
+/*
+ * Stops the writer when the series is done (the pending checkpoints are not
+ * needed any more) and removes the checkpoints
+ */
+void checkpoint_end(){
+    char path[4096];
+    int thread_id;
+
+    if(!checkpoint_active) return;
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(writer, NULL);
+
+    for(thread_id = 0; thread_id < checkpoint_num_threads; thread_id++){
+        checkpoint_path(path, sizeof(path), "state", thread_id);
+        unlink(path);
+        free(slots[thread_id].buffer);
+    }
+    checkpoint_path(path, sizeof(path), "manifest", -1);
+    unlink(path);
+    free(slots);
+    slots = NULL;
+    checkpoint_active = 0;
+}
+
+void checkpoint_get_stats(unsigned long * written, unsigned long * bytes, double * time, int * resumed){
+    *written = checkpoints_written;
+    *bytes = bytes_written;
+    *time = write_time;
+    *resumed = threads_resumed;
+}
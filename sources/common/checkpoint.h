@@ -0,0 +1,20 @@
+#ifndef CHECKPOINT
+#define CHECKPOINT
+
+#include <stddef.h>
+
+void checkpoint_enable(char *);
+void checkpoint_set_interval(long);
+void checkpoint_set_resume();
+int checkpoint_is_enabled();
+int checkpoint_is_resuming();
+int checkpoint_is_active();
+void checkpoint_begin(char *, long, long, int);
+int checkpoint_due(int);
+char * checkpoint_buffer(int, size_t);
+void checkpoint_submit(int, long, size_t);
+char * checkpoint_load(int, long *, size_t *);
+void checkpoint_end();
+void checkpoint_get_stats(unsigned long *, unsigned long *, double *, int *);
+
+#endif
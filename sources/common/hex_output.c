@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hex_output.h"
+#include "verification.h"
+
+
+#define HEX_OUTPUT_REFERENCE "resources/correct_pi_hex.txt"
+#define HEX_OUTPUT_CHUNK 1048576        // Hex digits converted at once by each thread (a multiple of 16)
+#define HEX_OUTPUT_LOG2_10 3.321928094887362
+#define HEX_OUTPUT_LOG10_2 0.30102999566398120
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Hexadecimal output (-hex) and verification against the hexadecimal reference     *
+ * (-hex-check)                                                                     *
+ *                                                                                  *
+ ************************************************************************************
+ * pi is a binary float, so its hexadecimal digits are the nibbles of its mantissa: *
+ * no radix conversion is needed. The limbs are read in place (the library gives    *
+ * the limbs and the bits of the integer part in the top limb) and each limb is     *
+ * printed as 16 hex digits with a table of the 256 pairs of digits, so the text    *
+ * is produced at the speed of a copy:                                              *
+ *                                                                                  *
+ *      3.243F6A8885A308D313198A2E03707344...                                       *
+ *                                                                                  *
+ * The threads take chunks of 1M digits: with -hex each chunk is written with       *
+ * pwrite at its offset of the file, with -hex-check it is compared with the        *
+ * reference (resources/correct_pi_hex.txt, 1M hex digits, mapped in memory) with   *
+ * the SSE2 compare of common/verification.c. -hex-check replaces the decimal       *
+ * check, so the jobs that only need hex digits never convert pi to decimal         *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int hex_output_fd = -1;
+static char * hex_output_path = NULL;
+static int hex_check_enabled = 0;
+static const char * hex_reference = NULL;          // Reference (mapped)
+static long hex_reference_header_bytes = 0;        // Bytes of the integer part and the point
+static long hex_reference_length = -1;             // Hex digits of the reference
+static unsigned long hex_reference_integer_part = 0;
+static char hex_pairs[512];                        // Text of the bytes 0x00 to 0xFF
+
+
+/*
+ * Creates the hex output file
+ */
+void hex_output_enable(char * path){
+    hex_output_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(hex_output_fd < 0){
+        printf("  The hex output file %s can not be created \n\n", path);
+        exit(-1);
+    }
+    hex_output_path = path;
+}
+
+int hex_output_is_enabled(){
+    return hex_output_fd >= 0;
+}
+
+char * hex_output_get_path(){
+    return hex_output_path;
+}
+
+void hex_check_enable(){
+    hex_check_enabled = 1;
+}
+
+int hex_check_is_enabled(){
+    return hex_check_enabled;
+}
+
+/*
+ * Hex digits equivalent to precision decimals
+ */
+long hex_output_digits(long precision){
+    return (long) (precision * HEX_OUTPUT_LOG2_10 / 4);
+}
+
+/*
+ * Decimals equivalent to digits hex digits
+ */
+long hex_output_decimals(long digits){
+    return (long) (4 * digits * HEX_OUTPUT_LOG10_2);
+}
+
+/*
+ * Maps the reference in memory (only the first time) and returns its hex digits
+ */
+long hex_reference_digits(){
+    struct stat status;
+    const char * point;
+    long bytes;
+    int fd;
+
+    if(hex_reference_length >= 0) return hex_reference_length;
+    fd = open(HEX_OUTPUT_REFERENCE, O_RDONLY);
+    if(fd < 0 || fstat(fd, &status) != 0 || status.st_size < 2){
+        printf("correct_pi_hex.txt not found \n");
+        exit(-1);
+    }
+    hex_reference = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(hex_reference == MAP_FAILED){
+        printf("correct_pi_hex.txt can not be mapped \n");
+        exit(-1);
+    }
+    madvise((void *) hex_reference, status.st_size, MADV_SEQUENTIAL);
+    bytes = status.st_size;
+    while(bytes > 0 && (hex_reference[bytes - 1] == '\n' || hex_reference[bytes - 1] == '\r')) bytes--;
+
+    point = memchr(hex_reference, '.', bytes);
+    hex_reference_header_bytes = (point == NULL) ? bytes : point - hex_reference + 1;
+    hex_reference_integer_part = strtoul(hex_reference, NULL, 16);
+    hex_reference_length = bytes - hex_reference_header_bytes;
+    return hex_reference_length;
+}
+
+/*
+ * Fills the table of the pairs of hex digits
+ */
+static void hex_output_init_pairs(){
+    const char * digits = "0123456789ABCDEF";
+    int i;
+
+    for(i = 0; i < 256; i++){
+        hex_pairs[2 * i] = digits[i >> 4];
+        hex_pairs[2 * i + 1] = digits[i & 15];
+    }
+}
+
+/*
+ * Limb j of the mantissa counting from the most significant one (0 out of the mantissa)
+ */
+static uint64_t hex_output_limb(hex_mantissa * mantissa, long j){
+    return (j >= 0 && j < mantissa -> num_limbs) ? mantissa -> limbs[mantissa -> num_limbs - 1 - j] : 0;
+}
+
+/*
+ * Limb k of the fraction (the first 64 bits after the point are the limb 0)
+ */
+static uint64_t hex_output_fraction_limb(hex_mantissa * mantissa, long k){
+    int shift = mantissa -> integer_bits;
+
+    if(shift == 64) return hex_output_limb(mantissa, k + 1);
+    return (hex_output_limb(mantissa, k) << shift) | (hex_output_limb(mantissa, k + 1) >> (64 - shift));
+}
+
+/*
+ * Hex digits that the mantissa holds after the point
+ */
+static long hex_output_mantissa_digits(hex_mantissa * mantissa){
+    return (mantissa -> num_limbs * 64 - mantissa -> integer_bits) / 4;
+}
+
+/*
+ * Writes the hex digits [offset, offset + length) of the fraction in digits (offset is a multiple of 16)
+ */
+static void hex_output_chunk(hex_mantissa * mantissa, long offset, long length, char * digits){
+    long k, first_limb = offset / 16, last_limb = (offset + length + 15) / 16;
+    uint64_t limb;
+    char text[16];
+    int i;
+
+    for(k = first_limb; k < last_limb; k++){
+        limb = hex_output_fraction_limb(mantissa, k);
+        for(i = 7; i >= 0; i--){
+            memcpy(text + 2 * i, hex_pairs + 2 * (limb & 0xFF), 2);
+            limb >>= 8;
+        }
+        if((k + 1) * 16 <= offset + length){
+            memcpy(digits + (k - first_limb) * 16, text, 16);
+        } else {
+            memcpy(digits + (k - first_limb) * 16, text, offset + length - k * 16);
+        }
+    }
+}
+
+/*
+ * Integer part of the mantissa
+ */
+static unsigned long hex_output_integer_part(hex_mantissa * mantissa){
+    return hex_output_limb(mantissa, 0) >> (64 - mantissa -> integer_bits);
+}
+
+/*
+ * Writes the integer part and the first digits hex digits of the fraction in the hex
+ * output file with num_threads threads. Returns the hex digits written
+ */
+long hex_output_write(hex_mantissa * mantissa, long digits, int num_threads){
+    char header[32];
+    long header_bytes, chunk, num_chunks;
+
+    if(digits > hex_output_mantissa_digits(mantissa)) digits = hex_output_mantissa_digits(mantissa);
+    hex_output_init_pairs();
+    header_bytes = snprintf(header, sizeof(header), "%lX.", hex_output_integer_part(mantissa));
+    if(pwrite(hex_output_fd, header, header_bytes, 0) != header_bytes){
+        printf("  The hex digits can not be written in %s \n\n", hex_output_path);
+        exit(-1);
+    }
+
+    num_chunks = (digits + HEX_OUTPUT_CHUNK - 1) / HEX_OUTPUT_CHUNK;
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for(chunk = 0; chunk < num_chunks; chunk++){
+        long offset = chunk * HEX_OUTPUT_CHUNK, length = (offset + HEX_OUTPUT_CHUNK < digits) ? HEX_OUTPUT_CHUNK : digits - offset;
+        long done = 0, written;
+        char * text = malloc(length);
+
+        if(text == NULL){
+            printf("Not enough memory to write the hex digits \n");
+            exit(-1);
+        }
+        hex_output_chunk(mantissa, offset, length, text);
+        while(done < length){
+            written = pwrite(hex_output_fd, text + done, length - done, header_bytes + offset + done);
+            if(written <= 0){
+                printf("  The hex digits can not be written in %s \n\n", hex_output_path);
+                exit(-1);
+            }
+            done += written;
+        }
+        free(text);
+    }
+
+    if(pwrite(hex_output_fd, "\n", 1, header_bytes + digits) != 1 || close(hex_output_fd) != 0){
+        printf("  The hex digits can not be written in %s \n\n", hex_output_path);
+        exit(-1);
+    }
+    hex_output_fd = -1;
+    return digits;
+}
+
+/*
+ * Returns the number of correct hex digits of the mantissa (compared with the
+ * reference by num_threads threads)
+ */
+long hex_output_check(hex_mantissa * mantissa, int num_threads){
+    long digits = hex_output_mantissa_digits(mantissa), first_mismatch, chunk, num_chunks;
+
+    if(digits > hex_reference_digits()) digits = hex_reference_digits();
+    if(hex_output_integer_part(mantissa) != hex_reference_integer_part) return 0;
+    hex_output_init_pairs();
+    first_mismatch = digits;
+
+    num_chunks = (digits + HEX_OUTPUT_CHUNK - 1) / HEX_OUTPUT_CHUNK;
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for(chunk = 0; chunk < num_chunks; chunk++){
+        long offset = chunk * HEX_OUTPUT_CHUNK, length = (offset + HEX_OUTPUT_CHUNK < digits) ? HEX_OUTPUT_CHUNK : digits - offset;
+        long mismatch;
+        char * text = malloc(length);
+
+        if(text == NULL){
+            printf("Not enough memory to check the hex digits \n");
+            exit(-1);
+        }
+        hex_output_chunk(mantissa, offset, length, text);
+        mismatch = offset + verification_first_mismatch(text, hex_reference + hex_reference_header_bytes + offset, length);
+        free(text);
+        if(mismatch < offset + length){
+            #pragma omp critical(hex_check)
+            {
+                if(mismatch < first_mismatch) first_mismatch = mismatch;
+            }
+        }
+    }
+    return first_mismatch;
+}
@@ -0,0 +1,23 @@
+#ifndef HEX_OUTPUT
+#define HEX_OUTPUT
+
+#include <stdint.h>
+
+typedef struct {
+    const uint64_t * limbs;             // Limbs of the mantissa (the least significant first)
+    long num_limbs;
+    int integer_bits;                   // Bits of the integer part at the top of the most significant limb (1 to 64)
+} hex_mantissa;
+
+void hex_output_enable(char *);
+int hex_output_is_enabled();
+char * hex_output_get_path();
+void hex_check_enable();
+int hex_check_is_enabled();
+long hex_output_digits(long);
+long hex_output_decimals(long);
+long hex_reference_digits();
+long hex_output_write(hex_mantissa *, long, int);
+long hex_output_check(hex_mantissa *, int);
+
+#endif
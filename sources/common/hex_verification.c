@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "hex_verification.h"
+#include "iterations.h"
+#include "numa.h"
+
+
+#define HEX_VERIFICATION_GUARD 16       // Last hex digits of the result that are not checked
+#define HEX_VERIFICATION_LOG2_10 3.321928094887362
+#define HEX_VERIFICATION_LOG10_2 0.30102999566398120
+#define HEX_VERIFICATION_TOLERANCE 1    // Units of the last hex digit that the extraction may differ
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Verification without reference: BBP hexadecimal digit extraction (-verify-hex)   *
+ *                                                                                  *
+ ************************************************************************************
+ * The BBP formula gives the hexadecimal digits of pi from the position d on        *
+ * without computing the previous ones:                                             *
+ *                                                                                  *
+ *      frac(16^d pi) = frac(4 S(1) - 2 S(4) - S(5) - S(6))                         *
+ *                                                                                  *
+ *      S(j) = sum_{k=0}^{d} (16^(d-k) mod (8k+j)) / (8k+j)                         *
+ *           + sum_{k>d} 16^(d-k) / (8k+j)                                          *
+ *                                                                                  *
+ * The modular powers are computed with 64 (or 128) bits integers and the sums in   *
+ * long double, keeping only the fraction. The terms are split in blocks among the  *
+ * threads. The sum accumulates an error of about d 2^-62, so when the fraction is  *
+ * that close to a boundary of the last digit, that digit may be off by one: the    *
+ * digits match when they differ by 1 in the last one at most (modulo 16^6)         *
+ *                                                                                  *
+ * The digits are extracted at 3 positions near the end of the result and compared  *
+ * with the digits of its binary fraction. An error in the computation changes      *
+ * every digit after it, so if the last position matches every decimal before it    *
+ * is taken as verified (that is how the record computations are validated). The    *
+ * check needs no reference and its time is O(d log d), apart from the execution    *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int hex_verification_enabled = 0;
+
+
+void hex_verification_enable(){
+    hex_verification_enabled = 1;
+}
+
+int hex_verification_is_enabled(){
+    return hex_verification_enabled;
+}
+
+/*
+ * 16^exponent mod modulus
+ */
+static unsigned long hex_verification_power_mod(unsigned long exponent, unsigned long modulus){
+    unsigned long result = 1, base = 16 % modulus;
+
+    if(modulus == 1) return 0;
+    if(modulus < (1UL << 32)){
+        while(exponent > 0){
+            if(exponent & 1) result = result * base % modulus;
+            base = base * base % modulus;
+            exponent >>= 1;
+        }
+    } else {
+        while(exponent > 0){
+            if(exponent & 1) result = (unsigned __int128) result * base % modulus;
+            base = (unsigned __int128) base * base % modulus;
+            exponent >>= 1;
+        }
+    }
+    return result;
+}
+
+/*
+ * Positions (hex digits after the point that are skipped) checked for a result of
+ * precision decimals, in ascending order. Returns the number of positions
+ */
+int hex_verification_positions(long precision, long * positions){
+    long last = (long) (precision * HEX_VERIFICATION_LOG2_10 / 4) - HEX_VERIFICATION_GUARD - HEX_VERIFICATION_DIGITS;
+    long step;
+    int i;
+
+    if(last < 0) return 0;
+    step = last / 64;
+    for(i = 0; i < HEX_VERIFICATION_POSITIONS; i++){
+        positions[i] = last - (HEX_VERIFICATION_POSITIONS - 1 - i) * step;
+    }
+    return HEX_VERIFICATION_POSITIONS;
+}
+
+/*
+ * Decimals covered by the hex digits up to the ones checked at position
+ */
+long hex_verification_decimals(long position){
+    return (long) (4 * (position + HEX_VERIFICATION_DIGITS) * HEX_VERIFICATION_LOG10_2);
+}
+
+/*
+ * Hex digits [position + 1, position + 6] of pi with the BBP formula (as an
+ * integer of 24 bits). It uses num_threads threads
+ */
+unsigned long hex_verification_bbp_digits(long position, int num_threads){
+    const int denominators[4] = {1, 4, 5, 6};
+    const long double factors[4] = {4, -2, -1, -1};
+    long double sum = 0, term, power;
+    long k;
+    int j;
+
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel private(k, j)
+    {
+        int thread_id = omp_get_thread_num();
+        long block_start, block_end;
+        long double partial = 0;
+        unsigned long modulus;
+
+        numa_bind_thread(thread_id, num_threads);
+        iterations_block_bounds(position + 1, thread_id, num_threads, &block_start, &block_end);
+        for(k = block_start; k < block_end; k++){
+            for(j = 0; j < 4; j++){
+                modulus = 8 * (unsigned long) k + denominators[j];
+                partial += factors[j] * hex_verification_power_mod(position - k, modulus) / modulus;
+            }
+            partial -= floorl(partial);
+        }
+
+        #pragma omp critical
+        {
+            sum += partial;
+            sum -= floorl(sum);
+        }
+    }
+
+    //Tail: 16^(position - k) < 1
+    for(k = position + 1, power = 1.0L / 16; power > 1e-24L; k++, power /= 16){
+        for(j = 0; j < 4; j++){
+            term = power / (8 * (long double) k + denominators[j]);
+            sum += factors[j] * term;
+        }
+    }
+    sum -= floorl(sum);
+
+    return (unsigned long) (sum * (1UL << (4 * HEX_VERIFICATION_DIGITS)));
+}
+
+/*
+ * 1 if the hex digits of the result match the digits extracted with the BBP formula
+ * (they may differ by HEX_VERIFICATION_TOLERANCE in the last digit, modulo 16^6)
+ */
+int hex_verification_match(unsigned long bbp_digits, unsigned long digits){
+    unsigned long modulus = 1UL << (4 * HEX_VERIFICATION_DIGITS);
+    unsigned long difference = (bbp_digits - digits) & (modulus - 1);
+
+    return difference <= HEX_VERIFICATION_TOLERANCE || modulus - difference <= HEX_VERIFICATION_TOLERANCE;
+}
@@ -0,0 +1,14 @@
+#ifndef HEX_VERIFICATION
+#define HEX_VERIFICATION
+
+#define HEX_VERIFICATION_POSITIONS 3    // Positions checked near the end of the result
+#define HEX_VERIFICATION_DIGITS 6       // Hex digits compared at each position
+
+void hex_verification_enable();
+int hex_verification_is_enabled();
+int hex_verification_positions(long, long *);
+long hex_verification_decimals(long);
+unsigned long hex_verification_bbp_digits(long, int);
+int hex_verification_match(unsigned long, unsigned long);
+
+#endif
@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "index_test.h"
+#include "iterations.h"
+#include "memory_planner.h"
+#include "../gmp/index_test.h"
+#include "../mpfr/index_test.h"
+
+
+#define A 13591409
+#define B 545140134
+#define C 640320
+#define INDEX_TEST_THREAD_FLOATS 16     // Biggest thread_floats of the engines (GMP-CHD-SME-INT-BLC)
+#define INDEX_TEST_SHARED_FLOATS 9      // Biggest shared_floats of the engines (CHD-CWE-SEQ)
+#define INDEX_TEST_TOLERANCE 1e-9       // Absolute tolerance of the log2 of the values
+#define INDEX_TEST_RELATIVE 1e-15       // Rounding of long double for the biggest log2
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Index test (-index-test): checks an execution of precision decimals with         *
+ * num_threads threads without computing pi                                         *
+ *                                                                                  *
+ ************************************************************************************
+ * The sizes (iterations and memory estimate) are checked against 128 bits          *
+ * arithmetic and the blocks of the threads must cover [0, num_iterations) once.    *
+ *                                                                                  *
+ * Then the functions of the engines of GMP and MPFR are called at the biggest      *
+ * indices of the execution with a tiny precision: the last term of BBP and         *
+ * Bellard, the seeds of dep_a, dep_b and dep_c at the last block of Chudnovsky,    *
+ * the jump of the block-cyclic distribution to the last term and the last term.    *
+ * An index that overflows (or an exponent out of the range of the library)         *
+ * gives a value far away from the expected one, which is computed with long        *
+ * double from a different expression:                                              *
+ *                                                                                  *
+ *      BBP:        log2(term) = -4n + log2(P(8n) / Q(8n))  (the terms that cancel  *
+ *                  each other are summed as one quotient of polynomials)           *
+ *      dep_a:      log2(dep_a(n)) = (lgamma(6n+1) - 3 lgamma(n+1)                  *
+ *                                    - lgamma(3n+1)) / ln(2)                       *
+ *      jumps:      log2(dep_a(n + j) / dep_a(n)) = SUMMATORY(log2 of each ratio)   *
+ *                                                                                  *
+ * The seeds of dep_a are exact factorials, which cost as much as the seed of the   *
+ * last thread of the real execution, so they are checked at the last block up to   *
+ * INDEX_TEST_SEED_MAX. The jump and the last term use dep_a(n - 1) / dep_a(from)   *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Prints a size of the index test: value must be equal to reference
+ * (computed with 128 bits)
+ */
+static int index_test_check_size(char * name, unsigned long value, __int128 reference){
+    int ok = reference >= 0 && reference <= (__int128) ULONG_MAX && (__int128) value == reference;
+
+    printf("  %-44s %20lu  %s \n", name, value, ok ? "ok" : "OVERFLOW");
+    return ok;
+}
+
+/*
+ * Checks that the blocks of num_threads threads cover [0, num_iterations) once
+ */
+static int index_test_blocks(char * name, long num_iterations, int num_threads){
+    long block_start, block_end, covered = 0;
+    int thread_id, ok = 1;
+
+    for (thread_id = 0; thread_id < num_threads; thread_id++) {
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
+        if (block_start != covered || block_end < block_start) ok = 0;
+        covered = block_end;
+    }
+    if (covered != num_iterations) ok = 0;
+    printf("  %-44s %20d  %s \n", name, num_threads, ok ? "ok" : "WRONG");
+    return ok;
+}
+
+/*
+ * Prints a value of the index test computed at the index n: mantissa * 2^exponent
+ * (as given by mpf_get_d_2exp and mpfr_get_d_2exp) must have the expected log2 and sign
+ */
+int index_test_check(char * name, long n, double mantissa, long exponent, long double expected_log2, int expected_sign){
+    long double value_log2, tolerance;
+    int ok;
+
+    tolerance = INDEX_TEST_TOLERANCE + fabsl(expected_log2) * INDEX_TEST_RELATIVE;
+    value_log2 = exponent + log2l(fabsl(mantissa));
+    ok = mantissa != 0 && isfinite(mantissa) && (mantissa > 0) == (expected_sign > 0)
+         && fabsl(value_log2 - expected_log2) <= tolerance;
+
+    printf("  %-44s %20ld  %s \n", name, n, ok ? "ok" : "WRONG");
+    return ok;
+}
+
+/*
+ * log2 of the term n of BBP: (4/(8n+1) - 2/(8n+4) - 1/(8n+5) - 1/(8n+6)) / 16^n
+ *      = (15x^2 + 151x + 376) / ((x+1)(x+4)(x+5)(x+6)) / 16^n,  x = 8n
+ */
+long double index_test_log2_bbp_term(long n){
+    long double x = 8.0L * n;
+
+    return log2l((15 * x * x + 151 * x + 376) / ((x + 1) * (x + 4) * (x + 5) * (x + 6))) - 4.0L * n;
+}
+
+/*
+ * log2 of the absolute value of the term n of Bellard (before the division by 64)
+ * and its sign
+ */
+long double index_test_log2_bellard_term(long n, int * sign){
+    long double x = 4.0L * n, y = 10.0L * n, sum;
+
+    sum = - 32 / (x + 1) - 1 / (x + 3) + 256 / (y + 1) - 64 / (y + 3) - 4 / (y + 5) - 4 / (y + 7) + 1 / (y + 9);
+    *sign = ((sum < 0) != (n % 2 != 0)) ? -1 : 1;
+    return log2l(fabsl(sum)) - 10.0L * n;
+}
+
+/*
+ * log2 of dep_a(n) = (6n)! / ((n!)^3 (3n)!)
+ */
+long double index_test_log2_dep_a(long n){
+    return (lgammal(6.0L * n + 1) - 3 * lgammal(n + 1.0L) - lgammal(3.0L * n + 1)) / logl(2);
+}
+
+/*
+ * log2 of dep_a(from + terms) / dep_a(from)
+ */
+long double index_test_log2_dep_a_jump(unsigned long from, unsigned long terms){
+    long double sum = 0, i;
+    unsigned long j;
+
+    for (j = 0; j < terms; j++) {
+        i = (long double) from + j;
+        sum += log2l((12 * i + 2) / (i + 1)) + log2l((12 * i + 6) / (i + 1)) + log2l((12 * i + 10) / (i + 1));
+    }
+    return sum;
+}
+
+/*
+ * log2 of the absolute value of dep_b(n) = (-640320)^3n
+ */
+long double index_test_log2_dep_b(long n){
+    return 3.0L * n * log2l(C);
+}
+
+/*
+ * log2 of dep_c(n) = 545140134n + 13591409
+ */
+long double index_test_log2_dep_c(long n){
+    return log2l((long double) B * n + A);
+}
+
+/*
+ * Index test: checks the sizes and the indices of an execution with
+ * precision decimals and num_threads threads without computing pi
+ */
+void index_test(long precision, int num_threads){
+    long bbp, bellard, chudnovsky, precision_bits;
+    __int128 wide_bbp, wide_floats;
+    int ok = 1;
+
+    if (precision <= 0 || precision > PRECISION_MAX) {
+        printf("  Precision should be between 1 and %ld. \n\n", PRECISION_MAX);
+        exit(-1);
+    }
+    precision_bits = precision * 8;
+    bbp = iterations_bbp(precision);
+    bellard = iterations_bellard(precision);
+    chudnovsky = iterations_chudnovsky(precision);
+    wide_bbp = (__int128) precision * 84 / 100;
+    wide_floats = (__int128) num_threads * (INDEX_TEST_THREAD_FLOATS + 6) + INDEX_TEST_SHARED_FLOATS + 8;
+
+    printf("  Index test for %ld decimals and %d threads \n", precision, num_threads);
+    printf("\n");
+
+    //Sizes
+    //precision * 0.84 is rounded in double, so it may be one iteration away from 84 precision / 100
+    ok &= index_test_check_size("BBP iterations", bbp, (bbp - wide_bbp <= 1 && wide_bbp - bbp <= 1) ? bbp : wide_bbp);
+    ok &= index_test_check_size("Bellard iterations", bellard, (__int128) precision / 3);
+    ok &= index_test_check_size("Chudnovsky iterations", chudnovsky, ((__int128) precision + 13) / 14);
+    ok &= index_test_check_size("Planner estimate (bytes)", memory_planner_estimate(precision_bits, num_threads, INDEX_TEST_THREAD_FLOATS, INDEX_TEST_SHARED_FLOATS),
+                                wide_floats * ((__int128) precision_bits / 8 + 64));
+    printf("\n");
+
+    //Distribution of the blocks
+    ok &= index_test_blocks("BBP blocks (threads)", bbp, num_threads);
+    ok &= index_test_blocks("Chudnovsky blocks (threads)", chudnovsky, num_threads);
+    ok &= index_test_blocks("Chudnovsky snake-like blocks (threads)", chudnovsky, num_threads * 2);
+    printf("\n");
+
+    //Functions of the engines at the biggest indices (n)
+    ok &= gmp_index_test(bbp, bellard, chudnovsky, num_threads);
+    printf("\n");
+    ok &= mpfr_index_test(bbp, bellard, chudnovsky, num_threads);
+    printf("\n");
+
+    if (!ok) {
+        printf("  Index test failed: the precision is too big for this build. \n\n");
+        exit(-1);
+    }
+    printf("  Index test passed \n\n");
+}
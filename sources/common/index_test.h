@@ -0,0 +1,16 @@
+#ifndef INDEX_TEST
+#define INDEX_TEST
+
+#define INDEX_TEST_PRECISION_BITS 256       // Precision of the terms of the test (the indices do not depend on it)
+#define INDEX_TEST_SEED_MAX 1000000         // Biggest n of the exact factorials of the seeds of dep_a
+
+void index_test(long, int);
+int index_test_check(char *, long, double, long, long double, int);
+long double index_test_log2_bbp_term(long);
+long double index_test_log2_bellard_term(long, int *);
+long double index_test_log2_dep_a(long);
+long double index_test_log2_dep_a_jump(unsigned long, unsigned long);
+long double index_test_log2_dep_b(long);
+long double index_test_log2_dep_c(long);
+
+#endif
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "iterations.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Number of iterations of the formulas and distribution of the iterations          *
+ *                                                                                  *
+ ************************************************************************************
+ * The precision, the iterations and the indices of the terms are long (64 bits),   *
+ * so billions of digits can be computed: with int, precision * 8 overflows at      *
+ * 268 million digits, and 6n (the factorials of Chudnovsky) or 8n + 6 (BBP) much   *
+ * earlier. The indices are passed to GMP and MPFR as unsigned long.                *
+ *                                                                                  *
+ * The block engines split [0, num_iterations) in num_threads contiguous blocks of  *
+ * ceil(num_iterations / num_threads) iterations. The last blocks may be shorter or *
+ * empty (block_start == block_end), but never go further than num_iterations       *
+ *                                                                                  *
+ * The block-cyclic engine deals blocks of k terms to the threads in turn. Each     *
+ * block ends with a jump of dep_a over the (num_threads - 1) k terms of the other  *
+ * threads, so a small k pays many jumps and a big k balances worse. k is 16 by     *
+ * default and can be set with -block-size                                          *
+ *                                                                                  *
+ * The index test (-index-test, index_test.c) checks them for a precision and a     *
+ * number of threads without computing pi                                           *
+ *                                                                                  *
+ ************************************************************************************/
+
+static long block_cyclic_size = ITERATIONS_BLOCK_CYCLIC_SIZE;
+
+/*
+ * Iterations of BBP (each term gives 1.2 decimals)
+ */
+long iterations_bbp(long precision){
+    return precision * 0.84;
+}
+
+/*
+ * Iterations of Bellard (each term gives 3 decimals)
+ */
+long iterations_bellard(long precision){
+    return precision / 3;
+}
+
+/*
+ * Iterations of Chudnovsky (each term gives 14 decimals, rounded up)
+ */
+long iterations_chudnovsky(long precision){
+    return (precision + 14 - 1) / 14;
+}
+
+/*
+ * Bounds [block_start, block_end) of the block of thread_id
+ */
+void iterations_block_bounds(long num_iterations, int thread_id, int num_threads, long * block_start, long * block_end){
+    long block_size = (num_iterations + num_threads - 1) / num_threads;
+
+    *block_start = (long) thread_id * block_size;
+    if (*block_start > num_iterations) *block_start = num_iterations;
+    *block_end = *block_start + block_size;
+    if (*block_end > num_iterations) *block_end = num_iterations;
+}
+
+/*
+ * Sets the terms of each block of the block-cyclic distribution
+ */
+void iterations_set_block_cyclic_size(long size){
+    block_cyclic_size = size;
+}
+
+/*
+ * Terms of each block of the block-cyclic distribution
+ */
+long iterations_block_cyclic_size(){
+    return block_cyclic_size;
+}
@@ -0,0 +1,16 @@
+#ifndef ITERATIONS
+#define ITERATIONS
+
+#include <limits.h>
+
+#define PRECISION_MAX (LONG_MAX / 8)     // precision * 8 bits must fit in a long
+#define ITERATIONS_BLOCK_CYCLIC_SIZE 16 // Terms of each block of GMP-CHD-SME-BLC-CYC (-block-size)
+
+long iterations_bbp(long);
+long iterations_bellard(long);
+long iterations_chudnovsky(long);
+void iterations_block_bounds(long, int, int, long *, long *);
+void iterations_set_block_cyclic_size(long);
+long iterations_block_cyclic_size();
+
+#endif
@@ -3,38 +3,256 @@
 #include <string.h>
 #include <stdbool.h>
 #include "printer.h"
+#include "memory_allocator.h"
+#include "numa.h"
+#include "memory_planner.h"
+#include "spill.h"
+#include "iterations.h"
+#include "index_test.h"
+#include "output.h"
+#include "packed.h"
+#include "verification.h"
+#include "hex_verification.h"
+#include "hex_output.h"
+#include "checkpoint.h"
+#include "bench.h"
+#include "phase_timers.h"
+#include "perf_counters.h"
 #include "../gmp/pi_calculator.h"
+#include "../gmp/streaming.h"
 #include "../mpfr/pi_calculator.h"
+#include "../decimal/pi_calculator.h"
 
 
 
 int incorrect_params(char* exec_name){
     printf("  Number of params are not correct. Try with:\n");
-    printf("    %s library algorithm precision num_threads [-csv] \n", exec_name);
+    printf("    %s library algorithm precision num_threads [-csv] [-alloc] [-hugepages] [-mem-limit MB] [-spill DIR] [-numa] [-block-size K] [-o FILE] [-packed FILE] \n", exec_name);
+    printf("                [-verify-hex] [-hex FILE] [-hex-check] [-checkpoint DIR [-checkpoint-every SECONDS] [-resume]] [-phases] [-counters] \n");
+    printf("    %s -index-test precision num_threads [-block-size K] \n", exec_name);
+    printf("    %s -lookup FILE first last \n", exec_name);
+    printf("    %s -promote FILE FILE \n", exec_name);
+    printf("    %s -stream decimals [FILE] [-csv] \n", exec_name);
+    printf("    %s -bench library algorithms precisions threads [-reps N] [-warmup N] [-weak] [-csv] \n", exec_name);
     printf("\n");
+    printf("    -csv        prints the results in csv format \n");
+    printf("    -alloc      uses the thread pools allocator and reports its counters \n");
+    printf("    -hugepages  same as -alloc, backing the blocks bigger than 2 MB with huge pages \n");
+    printf("    -mem-limit  refuses the execution if its estimated memory does not fit in MB megabytes \n");
+    printf("                and fits the parallel products in the budget (implies -alloc) \n");
+    printf("    -spill      spills the halves of the factorial trees (GMP-CHD-CAF-BLC) to a scratch file in DIR \n");
+    printf("    -numa       pins the threads to the NUMA nodes and reduces inside each node first \n");
+    printf("    -block-size terms of each block of the block-cyclic distribution of GMP-CHD-SME-BLC-CYC (16 by default) \n");
+    printf("    -o          converts pi to decimal in parallel and writes its decimals in FILE \n");
+    printf("    -packed     converts pi to decimal in parallel and packs its decimals in FILE (19 decimals in 8 bytes) \n");
+    printf("    -verify-hex verifies pi without reference: the hex digits near the end are compared with \n");
+    printf("                the BBP digit extraction (timed apart from the execution) \n");
+    printf("    -hex        writes the hex digits of pi in FILE straight from its limbs (no decimal conversion) \n");
+    printf("    -hex-check  counts the correct digits against the hex reference instead of the decimal one \n");
+    printf("    -checkpoint writes the state of each thread of the block engines in DIR every 600 seconds \n");
+    printf("                (or -checkpoint-every SECONDS) without stopping the threads \n");
+    printf("    -resume     goes on from the checkpoint in DIR \n");
+    printf("    -phases     times the seed, the series, the wait and the reduction of each thread and \n");
+    printf("                reports the load imbalance and the idle fraction \n");
+    printf("    -counters   same as -phases, counting the cycles, instructions, LLC misses, branch misses \n");
+    printf("                and dTLB misses of each phase of each thread (perf_event_open) \n");
+    printf("\n");
+    printf("    -index-test checks the sizes and the indices of every engine for a precision without computing pi \n");
+    printf("    -lookup     prints the decimals [first, last) of a packed FILE (the first decimal is 0) \n");
+    printf("    -promote    extends the packed reference with the decimals where two packed results \n");
+    printf("                of different formulas agree \n");
+    printf("    -stream     streams the decimals to stdout (or FILE) as they become final (Gibbons spigot) \n");
+    printf("                and reports the time to the first and to the 10^j-th decimal \n");
+    printf("    -bench      runs every combination of the lists (separated by commas: 5,7 1000,10000 1,2,4) \n");
+    printf("                -warmup times (0 by default) and -reps times (5 by default) in the same process and \n");
+    printf("                reports min, median, p95, stddev, speedup and efficiency (-weak scales the precision \n");
+    printf("                with the threads) \n");
+    printf("\n");
+}
+
+/*
+ * Parses the precision (a long: billions of decimals can be requested)
+ */
+long parse_precision(char * text){
+    char * end;
+    long precision = strtol(text, &end, 10);
+
+    if (*text == '\0' || *end != '\0' || precision <= 0 || precision > PRECISION_MAX) {
+        printf("  Precision should be a number between 1 and %ld. \n\n", PRECISION_MAX);
+        exit(-1);
+    }
+    return precision;
 }
 
 int main(int argc, char **argv){    
 
     //Check the number of parameters are correct
-    bool print_in_csv_format; 
+    bool print_in_csv_format = false, use_memory_allocator = false, use_huge_pages = false, use_numa = false;
+    unsigned long allocations, reallocations, frees, reused;
+    unsigned long huge_explicit_bytes, huge_transparent_bytes, huge_mappings, peak;
+    unsigned long checkpoints_written, checkpoint_bytes;
+    double checkpoint_time;
+    int threads_resumed;
+    long live;
+    int i;
 
-    if (argc == 6 && strcmp(argv[5], "-csv") == 0) {
-        print_in_csv_format = true;    
-    } 
-    else if (argc == 5) {
-        print_title();
-        print_in_csv_format = false;
+    //Index test mode: pi is not computed
+    if ((argc == 4 || (argc == 6 && strcmp(argv[4], "-block-size") == 0 && atol(argv[5]) > 0)) && strcmp(argv[1], "-index-test") == 0) {
+        if (argc == 6) iterations_set_block_cyclic_size(atol(argv[5]));
+        index_test(parse_precision(argv[2]), (atoi(argv[3]) <= 0) ? 1 : atoi(argv[3]));
+        exit(0);
     }
-    else {
+
+    //Lookup mode: a range of decimals of a packed file is printed
+    if (argc == 5 && strcmp(argv[1], "-lookup") == 0) {
+        packed_lookup(argv[2], atol(argv[3]), atol(argv[4]));
+        exit(0);
+    }
+
+    //Promotion mode: two packed results extend the reference
+    if (argc == 4 && strcmp(argv[1], "-promote") == 0) {
+        verification_promote(argv[2], argv[3]);
+        exit(0);
+    }
+
+    //Streaming mode: the decimals are flushed as they become final
+    if (argc >= 3 && argc <= 5 && strcmp(argv[1], "-stream") == 0) {
+        char * stream_path = NULL;
+        for (i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "-csv") == 0) {
+                print_in_csv_format = true;
+            } else {
+                stream_path = argv[i];
+            }
+        }
+        gmp_stream_pi(parse_precision(argv[2]), stream_path, print_in_csv_format);
+        if (print_in_csv_format) {
+            printf("\n");
+        }
+        exit(0);
+    }
+
+    //Benchmark mode: repetitions and sweeps in the same process
+    if (argc >= 6 && strcmp(argv[1], "-bench") == 0) {
+        void (*calculate)(int, long, int, bool) = NULL;
+        int repetitions = 5, warmup = 0;
+        bool weak_scaling = false;
+
+        for (i = 6; i < argc; i++) {
+            if (strcmp(argv[i], "-csv") == 0) {
+                print_in_csv_format = true;
+            }
+            else if (strcmp(argv[i], "-reps") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                repetitions = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "-warmup") == 0 && i + 1 < argc && atoi(argv[i + 1]) >= 0) {
+                warmup = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "-weak") == 0) {
+                weak_scaling = true;
+            }
+            else {
+                incorrect_params(argv[0]);
+                exit(-1);
+            }
+        }
+        if (strcmp(argv[2], "GMP") == 0) calculate = gmp_calculate_pi;
+        else if (strcmp(argv[2], "MPFR") == 0) calculate = mpfr_calculate_pi;
+        else if (strcmp(argv[2], "DEC") == 0) calculate = dec_calculate_pi;
+        else {
+            printf("  Library selected is not correct. Try with GMP, MPFR or DEC. \n\n");
+            exit(-1);
+        }
+        bench_run(argv[2], calculate, argv[3], argv[4], argv[5], repetitions, warmup, weak_scaling, print_in_csv_format);
+        exit(0);
+    }
+
+    if (argc < 5) {
         incorrect_params(argv[0]);
         exit(-1);
     }
 
+    //Optional params
+    for (i = 5; i < argc; i++) {
+        if (strcmp(argv[i], "-csv") == 0) {
+            print_in_csv_format = true;
+        }
+        else if (strcmp(argv[i], "-alloc") == 0) {
+            use_memory_allocator = true;
+        }
+        else if (strcmp(argv[i], "-hugepages") == 0) {
+            use_memory_allocator = true;
+            use_huge_pages = true;
+        }
+        else if (strcmp(argv[i], "-mem-limit") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            memory_planner_set_limit(atol(argv[++i]) * 1048576UL);
+            use_memory_allocator = true;
+        }
+        else if (strcmp(argv[i], "-spill") == 0 && i + 1 < argc) {
+            spill_enable(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-numa") == 0) {
+            use_numa = true;
+        }
+        else if (strcmp(argv[i], "-block-size") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            iterations_set_block_cyclic_size(atol(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_enable(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_enable(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-checkpoint-every") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            checkpoint_set_interval(atol(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-resume") == 0) {
+            checkpoint_set_resume();
+        }
+        else if (strcmp(argv[i], "-verify-hex") == 0) {
+            hex_verification_enable();
+        }
+        else if (strcmp(argv[i], "-hex") == 0 && i + 1 < argc) {
+            hex_output_enable(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-hex-check") == 0) {
+            hex_check_enable();
+        }
+        else if (strcmp(argv[i], "-packed") == 0 && i + 1 < argc) {
+            packed_enable(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-phases") == 0) {
+            phase_timers_enable();
+        }
+        else if (strcmp(argv[i], "-counters") == 0) {
+            phase_timers_enable();
+            perf_counters_enable();
+        }
+        else {
+            incorrect_params(argv[0]);
+            exit(-1);
+        }
+    }
+    if (checkpoint_is_resuming() && !checkpoint_is_enabled()) {
+        printf("  -resume needs the directory of the checkpoint (-checkpoint DIR). \n\n");
+        exit(-1);
+    }
+    if (!print_in_csv_format) {
+        print_title();
+    }
+
+    //The allocator must be registered before any GMP or MPFR variable is initialized
+    if (use_memory_allocator) {
+        memory_allocator_enable(use_huge_pages);
+    }
+    if (use_numa) {
+        numa_enable();
+    }
+
     //Take algorithm and precision from params
     char *library = argv[1];
     int algorithm = atoi(argv[2]);    
-    int precision = atoi(argv[3]);
+    long precision = parse_precision(argv[3]);
     int num_threads = (atoi(argv[4]) <= 0) ? 1 : atoi(argv[4]);
 
     if (strcmp(library, "GMP") == 0) {
@@ -43,14 +261,78 @@ int main(int argc, char **argv){
     else if (strcmp(library, "MPFR") == 0) {
         mpfr_calculate_pi(algorithm, precision, num_threads, print_in_csv_format);
     } 
+    else if (strcmp(library, "DEC") == 0) {
+        dec_calculate_pi(algorithm, precision, num_threads, print_in_csv_format);
+    } 
     else 
     {
         printf("  Library selected is not correct. Try with: \n");
         printf("      GMP -> GNU Multiple Precision Arithmetic Library \n");
         printf("      MPFR -> Multiple Precision Floating Point Reliable Library \n");
+        printf("      DEC -> Fixed point in base 10^18 (experimental, BBP, Bellard and Chudnovsky) \n");
         printf("\n");
         exit(-1);
     }
 
+    if (use_memory_allocator) {
+        memory_allocator_get_stats(&allocations, &reallocations, &frees, &reused);
+        if (print_in_csv_format) {
+            print_memory_allocator_stats_csv(allocations, reallocations, frees, reused);
+        } else {
+            print_memory_allocator_stats(allocations, reallocations, frees, reused);
+        }
+    }
+    if (use_memory_allocator) {
+        unsigned long phase_peaks[ALLOCATOR_NUM_PHASES], phase_counts[ALLOCATOR_NUM_PHASES];
+        unsigned long thread_peaks[num_threads], thread_counts[num_threads];
+        memory_allocator_get_accounting(&peak, &live, phase_peaks, phase_counts, thread_peaks, thread_counts, num_threads);
+        if (print_in_csv_format) {
+            print_memory_accounting_csv(peak, live, phase_peaks, phase_counts, thread_peaks, thread_counts, num_threads,
+                                        memory_planner_get_estimate(), memory_planner_get_limit());
+        } else {
+            print_memory_accounting(peak, live, phase_peaks, phase_counts, thread_peaks, thread_counts, num_threads,
+                                    memory_planner_get_estimate(), memory_planner_get_limit());
+        }
+    }
+    if (use_huge_pages) {
+        memory_allocator_get_huge_page_stats(&huge_explicit_bytes, &huge_transparent_bytes, &huge_mappings);
+        if (print_in_csv_format) {
+            print_huge_page_stats_csv(huge_explicit_bytes, huge_transparent_bytes, huge_mappings);
+        } else {
+            print_huge_page_stats(huge_explicit_bytes, huge_transparent_bytes, huge_mappings);
+        }
+    }
+    if (checkpoint_is_enabled()) {
+        checkpoint_get_stats(&checkpoints_written, &checkpoint_bytes, &checkpoint_time, &threads_resumed);
+        if (print_in_csv_format) {
+            print_checkpoint_stats_csv(checkpoints_written, checkpoint_bytes, checkpoint_time, threads_resumed);
+        } else {
+            print_checkpoint_stats(checkpoints_written, checkpoint_bytes, checkpoint_time, threads_resumed);
+        }
+    }
+    if (phase_timers_is_enabled()) {
+        double phase_times[num_threads * TIMERS_NUM_PHASES], cpu_times[num_threads], imbalance, idle_fraction;
+        int timed_threads = phase_timers_get_stats(phase_times, cpu_times, &imbalance, &idle_fraction, num_threads);
+        if (print_in_csv_format) {
+            print_phase_timers_csv(phase_times, cpu_times, timed_threads, imbalance, idle_fraction);
+        } else {
+            print_phase_timers(phase_times, cpu_times, timed_threads, imbalance, idle_fraction);
+        }
+        if (perf_counters_is_enabled()) {
+            long counters[timed_threads * TIMERS_NUM_PHASES * COUNTERS_NUM];
+            char * reason;
+            int available = perf_counters_available(&reason);
+            perf_counters_get(counters, timed_threads);
+            if (print_in_csv_format) {
+                print_perf_counters_csv(counters, timed_threads, available, reason);
+            } else {
+                print_perf_counters(counters, timed_threads, available, reason);
+            }
+        }
+    }
+    if (print_in_csv_format) {
+        printf("\n");
+    }
+
     exit(0);
 }
@@ -0,0 +1,394 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <gmp.h>
+#include <omp.h>
+#include "memory_allocator.h"
+
+
+#define ALLOCATOR_MIN_CLASS 5           // Smallest block: 2^5 bytes
+#define ALLOCATOR_MAX_CLASS 21          // Biggest pooled block: 2^21 bytes (bigger ones are direct blocks)
+#define ALLOCATOR_HEADER 16             // Keeps the 16 bytes alignment of malloc
+#define ALLOCATOR_DIRECT 0              // Size classes of the blocks that are not pooled: malloc,
+#define ALLOCATOR_MAPPED 1              // mmap with transparent huge pages (madvise)
+#define ALLOCATOR_HUGETLB 2             // and mmap with explicit huge pages (MAP_HUGETLB)
+#define HUGE_PAGE_SIZE (2UL << 20)
+#define ALLOCATOR_MAX_THREADS 256
+#define ALLOCATOR_ACCOUNTING_BATCH 65536    // Bytes a thread allocates or frees before publishing them
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Memory allocator for GMP and MPFR (registered with mp_set_memory_functions)      *
+ *                                                                                  *
+ ************************************************************************************
+ * The engines resize their temporaries at every iteration and all the threads      *
+ * share the same malloc. With this allocator each thread keeps its own pools of    *
+ * free blocks, one for each power of two size (size class), so most of the         *
+ * allocations are served without locks:                                            *
+ *                                                                                  *
+ *      | header (size class) | data ...                    |                       *
+ *      <------ 16 bytes -----><--- 2^size_class - 16 bytes --->                    *
+ *                                                                                  *
+ * A freed block goes to the pool of the thread that frees it. The pools are        *
+ * released in bulk by memory_allocator_release_thread at the end of the work of    *
+ * each thread. Blocks bigger than 2^21 bytes are direct blocks, served by malloc   *
+ *                                                                                  *
+ ************************************************************************************
+ * With huge pages the direct blocks are mapped with 2 MB pages, so the long        *
+ * streaming products over them do not thrash the TLB:                              *
+ *                                                                                  *
+ *      1. mmap with MAP_HUGETLB (pages reserved by the administrator)              *
+ *      2. If there are no reserved pages: mmap + madvise(MADV_HUGEPAGE)            *
+ *                                                                                  *
+ * The header of the mapped blocks also stores the length of the mapping. The       *
+ * memory backed by huge pages is measured with the length of the MAP_HUGETLB       *
+ * mappings and the AnonHugePages of /proc/self/smaps_rollup (for the transparent   *
+ * ones), sampled before each mapped block is released                              *
+ *                                                                                  *
+ ************************************************************************************
+ * Accounting: the bytes requested by GMP and MPFR are added to the live bytes of   *
+ * the thread, which publishes them in the global counter every 64 KB (so the peak  *
+ * may be off by 64 KB per thread). The peaks are kept for the whole execution, for *
+ * each phase (series, reduction and final operations) and for each thread          *
+ *                                                                                  *
+ ************************************************************************************/
+
+static __thread void * free_blocks[ALLOCATOR_MAX_CLASS + 1];
+
+//Counters of each thread. They are added to the global ones when the thread releases its pools
+static __thread unsigned long thread_allocations, thread_reallocations, thread_frees, thread_reused;
+static unsigned long total_allocations, total_reallocations, total_frees, total_reused;
+
+//Accounting of the live bytes
+static __thread int thread_phase = ALLOCATOR_PHASE_SERIES;
+static __thread long thread_live_bytes, thread_unpublished_bytes, thread_peak_bytes;
+static __thread unsigned long thread_phase_allocations[ALLOCATOR_NUM_PHASES];
+static long live_bytes;
+static unsigned long peak_bytes, phase_peak_bytes[ALLOCATOR_NUM_PHASES], phase_allocations[ALLOCATOR_NUM_PHASES];
+static unsigned long threads_peak_bytes[ALLOCATOR_MAX_THREADS], threads_allocations[ALLOCATOR_MAX_THREADS];
+
+//Huge pages counters (the mapped blocks are big and few, so they are updated atomically)
+static unsigned long hugetlb_bytes, hugetlb_peak_bytes, transparent_peak_bytes, huge_page_mappings;
+
+static int memory_allocator_enabled = 0;
+static int memory_allocator_huge_pages = 0;
+
+
+static inline size_t * memory_allocator_header(void * ptr){
+    return (size_t *) ((char *) ptr - ALLOCATOR_HEADER);
+}
+
+/*
+ * Smallest size class whose blocks can store size bytes (and the header)
+ */
+static inline int memory_allocator_size_class(size_t size){
+    int size_class = ALLOCATOR_MIN_CLASS;
+    size += ALLOCATOR_HEADER;
+    while(size_class <= ALLOCATOR_MAX_CLASS && ((size_t) 1 << size_class) < size) size_class++;
+    return (size_class > ALLOCATOR_MAX_CLASS) ? ALLOCATOR_DIRECT : size_class;
+}
+
+static void memory_allocator_out_of_memory(size_t size){
+    printf("  Memory allocator: not enough memory for %zu bytes \n", size);
+    exit(-1);
+}
+
+/*
+ * Adds the unpublished bytes of the thread to the global live bytes
+ */
+static void memory_allocator_publish(){
+    long live;
+
+    #pragma omp atomic capture
+    live = live_bytes += thread_unpublished_bytes;
+    thread_unpublished_bytes = 0;
+    if(live > (long) phase_peak_bytes[thread_phase]){
+        #pragma omp critical (memory_allocator_peak)
+        {
+            if(live > (long) phase_peak_bytes[thread_phase]) phase_peak_bytes[thread_phase] = live;
+            if(live > (long) peak_bytes) peak_bytes = live;
+        }
+    }
+}
+
+static inline void memory_allocator_account(long bytes){
+    thread_live_bytes += bytes;
+    if(thread_live_bytes > thread_peak_bytes) thread_peak_bytes = thread_live_bytes;
+    thread_unpublished_bytes += bytes;
+    if(thread_unpublished_bytes >= ALLOCATOR_ACCOUNTING_BATCH || thread_unpublished_bytes <= -ALLOCATOR_ACCOUNTING_BATCH){
+        memory_allocator_publish();
+    }
+}
+
+/*
+ * Bytes of the process backed by transparent huge pages
+ */
+static unsigned long memory_allocator_transparent_huge_bytes(){
+    FILE * file;
+    char line[256];
+    unsigned long kilobytes = 0;
+
+    file = fopen("/proc/self/smaps_rollup", "r");
+    if(file == NULL) return 0;
+    while(fgets(line, sizeof(line), file) != NULL){
+        if(sscanf(line, "AnonHugePages: %lu kB", &kilobytes) == 1) break;
+    }
+    fclose(file);
+    return kilobytes * 1024;
+}
+
+/*
+ * Allocates a direct block (header included)
+ */
+static size_t * memory_allocator_direct_alloc(size_t size){
+    size_t * header;
+    size_t length;
+    unsigned long peak;
+
+    size += ALLOCATOR_HEADER;
+    if(!memory_allocator_huge_pages){
+        header = malloc(size);
+        if(header == NULL) memory_allocator_out_of_memory(size);
+        header[0] = ALLOCATOR_DIRECT;
+        return header;
+    }
+
+    length = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    header = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(header != MAP_FAILED){
+        header[0] = ALLOCATOR_HUGETLB;
+        #pragma omp atomic capture
+        peak = hugetlb_bytes += length;
+        #pragma omp critical (memory_allocator_huge_pages)
+        if(peak > hugetlb_peak_bytes) hugetlb_peak_bytes = peak;
+    } else {
+        header = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(header == MAP_FAILED) memory_allocator_out_of_memory(size);
+        madvise(header, length, MADV_HUGEPAGE);
+        header[0] = ALLOCATOR_MAPPED;
+    }
+    header[1] = length;
+    #pragma omp atomic
+    huge_page_mappings++;
+    return header;
+}
+
+static void memory_allocator_direct_free(size_t * header){
+    unsigned long transparent_bytes;
+
+    if(header[0] == ALLOCATOR_DIRECT){
+        free(header);
+        return;
+    }
+    if(header[0] == ALLOCATOR_HUGETLB){
+        #pragma omp atomic
+        hugetlb_bytes -= header[1];
+    } else {
+        transparent_bytes = memory_allocator_transparent_huge_bytes();
+        #pragma omp critical (memory_allocator_huge_pages)
+        if(transparent_bytes > transparent_peak_bytes) transparent_peak_bytes = transparent_bytes;
+    }
+    munmap(header, header[1]);
+}
+
+/*
+ * Resizes a direct block. The new size is also a direct one
+ */
+static size_t * memory_allocator_direct_realloc(size_t * header, size_t old_size, size_t new_size){
+    size_t * new_header;
+
+    if(header[0] == ALLOCATOR_DIRECT){
+        new_header = realloc(header, new_size + ALLOCATOR_HEADER);
+        if(new_header == NULL) memory_allocator_out_of_memory(new_size);
+        return new_header;
+    }
+    //The mapping already has enough room
+    if(new_size + ALLOCATOR_HEADER <= header[1]) return header;
+
+    new_header = memory_allocator_direct_alloc(new_size);
+    memcpy((char *) new_header + ALLOCATOR_HEADER, (char *) header + ALLOCATOR_HEADER, old_size);
+    memory_allocator_direct_free(header);
+    return new_header;
+}
+
+void * memory_allocator_alloc(size_t size){
+    int size_class = memory_allocator_size_class(size);
+    size_t * header;
+
+    thread_allocations++;
+    thread_phase_allocations[thread_phase]++;
+    memory_allocator_account(size);
+    if(size_class == ALLOCATOR_DIRECT){
+        return (char *) memory_allocator_direct_alloc(size) + ALLOCATOR_HEADER;
+    }
+    if(free_blocks[size_class] != NULL){
+        //The first bytes of a free block point to the next free block of the pool
+        header = free_blocks[size_class];
+        free_blocks[size_class] = *((void **) header);
+        thread_reused++;
+    } else {
+        header = malloc((size_t) 1 << size_class);
+        if(header == NULL) memory_allocator_out_of_memory(size);
+    }
+    header[0] = size_class;
+    return (char *) header + ALLOCATOR_HEADER;
+}
+
+void memory_allocator_free(void * ptr, size_t size){
+    size_t * header = memory_allocator_header(ptr);
+    int size_class = header[0];
+
+    thread_frees++;
+    memory_allocator_account(-(long) size);
+    if(size_class < ALLOCATOR_MIN_CLASS){
+        memory_allocator_direct_free(header);
+    } else {
+        *((void **) header) = free_blocks[size_class];
+        free_blocks[size_class] = header;
+    }
+}
+
+void * memory_allocator_realloc(void * ptr, size_t old_size, size_t new_size){
+    size_t * header = memory_allocator_header(ptr);
+    int size_class = header[0];
+    int new_size_class = memory_allocator_size_class(new_size);
+    void * new_ptr;
+
+    thread_reallocations++;
+    memory_allocator_account((long) new_size - (long) old_size);
+    //The block is big enough (the pooled blocks can not shrink)
+    if(size_class >= ALLOCATOR_MIN_CLASS && new_size_class == size_class){
+        return ptr;
+    }
+    if(size_class < ALLOCATOR_MIN_CLASS && new_size_class == ALLOCATOR_DIRECT){
+        return (char *) memory_allocator_direct_realloc(header, old_size, new_size) + ALLOCATOR_HEADER;
+    }
+
+    new_ptr = memory_allocator_alloc(new_size);
+    memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+    memory_allocator_free(ptr, old_size);
+    //Only the reallocation is counted (and its bytes were already accounted)
+    thread_allocations--;
+    thread_phase_allocations[thread_phase]--;
+    thread_frees--;
+    memory_allocator_account((long) old_size - (long) new_size);
+    return new_ptr;
+}
+
+/*
+ * Registers the allocator. It must be called before any GMP or MPFR
+ * variable is initialized. With huge_pages the direct blocks are
+ * backed by 2 MB pages
+ */
+void memory_allocator_enable(int huge_pages){
+    mp_set_memory_functions(memory_allocator_alloc, memory_allocator_realloc, memory_allocator_free);
+    memory_allocator_enabled = 1;
+    memory_allocator_huge_pages = huge_pages;
+}
+
+/*
+ * Adds the counters of the thread to the global ones
+ */
+static void memory_allocator_flush_counters(){
+    int phase, thread_id = omp_get_thread_num();
+
+    memory_allocator_publish();
+    for(phase = 0; phase < ALLOCATOR_NUM_PHASES; phase++){
+        #pragma omp atomic
+        phase_allocations[phase] += thread_phase_allocations[phase];
+        thread_phase_allocations[phase] = 0;
+    }
+    if(thread_id < ALLOCATOR_MAX_THREADS){
+        if(thread_peak_bytes > (long) threads_peak_bytes[thread_id]) threads_peak_bytes[thread_id] = thread_peak_bytes;
+        threads_allocations[thread_id] += thread_allocations;
+    }
+    #pragma omp atomic
+    total_allocations += thread_allocations;
+    #pragma omp atomic
+    total_reallocations += thread_reallocations;
+    #pragma omp atomic
+    total_frees += thread_frees;
+    #pragma omp atomic
+    total_reused += thread_reused;
+    thread_allocations = thread_reallocations = thread_frees = thread_reused = 0;
+}
+
+/*
+ * Frees the pools of the calling thread. It is called at the end of the
+ * work of each thread (next to mpfr_free_cache in the MPFR engines)
+ */
+void memory_allocator_release_thread(){
+    int size_class;
+    void * block;
+
+    if(!memory_allocator_enabled) return;
+    for(size_class = ALLOCATOR_MIN_CLASS; size_class <= ALLOCATOR_MAX_CLASS; size_class++){
+        while(free_blocks[size_class] != NULL){
+            block = free_blocks[size_class];
+            free_blocks[size_class] = *((void **) block);
+            free(block);
+        }
+    }
+    memory_allocator_flush_counters();
+}
+
+/*
+ * Sets the phase of the calling thread. The allocations and the peaks
+ * reached from now on are attributed to it
+ */
+void memory_allocator_set_phase(int phase){
+    if(!memory_allocator_enabled) return;
+    memory_allocator_publish();
+    thread_phase = phase;
+}
+
+int memory_allocator_is_enabled(){
+    return memory_allocator_enabled;
+}
+
+/*
+ * Returns the counters of all the threads that have released their pools
+ * (and the ones of the calling thread)
+ */
+void memory_allocator_get_stats(unsigned long * allocations, unsigned long * reallocations, unsigned long * frees, unsigned long * reused){
+    memory_allocator_flush_counters();
+    *allocations = total_allocations;
+    *reallocations = total_reallocations;
+    *frees = total_frees;
+    *reused = total_reused;
+}
+
+/*
+ * Returns the peak of memory backed by explicit (MAP_HUGETLB) and transparent
+ * huge pages, and the number of blocks mapped with huge pages
+ */
+void memory_allocator_get_huge_page_stats(unsigned long * explicit_bytes, unsigned long * transparent_bytes, unsigned long * mappings){
+    unsigned long current = memory_allocator_transparent_huge_bytes();
+    if(current > transparent_peak_bytes) transparent_peak_bytes = current;
+    *explicit_bytes = hugetlb_peak_bytes;
+    *transparent_bytes = transparent_peak_bytes;
+    *mappings = huge_page_mappings;
+}
+
+/*
+ * Returns the peak and the current live bytes, the peak and the allocations of each
+ * phase and the peak and the allocations of the first num_threads threads
+ */
+void memory_allocator_get_accounting(unsigned long * peak, long * live, unsigned long * phase_peaks, unsigned long * phase_counts,
+                                     unsigned long * thread_peaks, unsigned long * thread_counts, int num_threads){
+    int i;
+
+    memory_allocator_flush_counters();
+    *peak = peak_bytes;
+    *live = live_bytes;
+    for(i = 0; i < ALLOCATOR_NUM_PHASES; i++){
+        phase_peaks[i] = phase_peak_bytes[i];
+        phase_counts[i] = phase_allocations[i];
+    }
+    for(i = 0; i < num_threads; i++){
+        thread_peaks[i] = (i < ALLOCATOR_MAX_THREADS) ? threads_peak_bytes[i] : 0;
+        thread_counts[i] = (i < ALLOCATOR_MAX_THREADS) ? threads_allocations[i] : 0;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef MEMORY_ALLOCATOR
+#define MEMORY_ALLOCATOR
+
+#define ALLOCATOR_NUM_PHASES 3
+#define ALLOCATOR_PHASE_SERIES 0        // Setup and terms of the series
+#define ALLOCATOR_PHASE_REDUCTION 1     // Reduction of the partial results
+#define ALLOCATOR_PHASE_FINAL 2         // Final operations (division by the constant)
+
+void memory_allocator_enable(int);
+void memory_allocator_release_thread();
+void memory_allocator_set_phase(int);
+int memory_allocator_is_enabled();
+void memory_allocator_get_stats(unsigned long *, unsigned long *, unsigned long *, unsigned long *);
+void memory_allocator_get_huge_page_stats(unsigned long *, unsigned long *, unsigned long *);
+void memory_allocator_get_accounting(unsigned long *, long *, unsigned long *, unsigned long *, unsigned long *, unsigned long *, int);
+
+#endif
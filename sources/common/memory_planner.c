@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#define PLANNER_OPERATION_FLOATS 6      // Temporaries of a division or a product of each thread
+#define PLANNER_FINAL_FLOATS 8          // Newton division and square root of the constant
+#define PLANNER_FLOAT_OVERHEAD 64       // Header and extra limbs of each float
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Memory planner: estimates the memory of an execution before it starts            *
+ *                                                                                  *
+ ************************************************************************************
+ * The memory of the algorithms is dominated by the floats of the working precision *
+ * (the variables of each thread, the shared ones and the temporaries of the        *
+ * operations):                                                                     *
+ *                                                                                  *
+ *   estimate = (num_threads (thread_floats + 6) + shared_floats + 8) float_bytes   *
+ *                                                                                  *
+ * The engines add their own tables (like the factorial checkpoints) and the rest   *
+ * of the budget is left to the temporaries of the parallel multiplications. If the *
+ * estimate does not fit in the limit the execution is refused before it starts.    *
+ * The peaks measured by the allocator (-alloc) are printed next to the estimate,   *
+ * so the model can be checked                                                      *
+ *                                                                                  *
+ ************************************************************************************/
+
+static unsigned long memory_limit = 0;      // Bytes (0: no limit)
+static unsigned long memory_estimate = 0;
+
+
+void memory_planner_set_limit(unsigned long bytes){
+    memory_limit = bytes;
+}
+
+unsigned long memory_planner_get_limit(){
+    return memory_limit;
+}
+
+unsigned long memory_planner_get_estimate(){
+    return memory_estimate;
+}
+
+/*
+ * True if there is no limit or bytes fit in it
+ */
+int memory_planner_fits(unsigned long bytes){
+    return memory_limit == 0 || bytes <= memory_limit;
+}
+
+/*
+ * Bytes of a float with precision_bits bits
+ */
+unsigned long memory_planner_float_bytes(long precision_bits){
+    return (unsigned long) precision_bits / 8 + PLANNER_FLOAT_OVERHEAD;
+}
+
+/*
+ * Estimated bytes of an algorithm with thread_floats floats in each thread
+ * and shared_floats floats shared by all the threads
+ */
+unsigned long memory_planner_estimate(long precision_bits, int num_threads, int thread_floats, int shared_floats){
+    unsigned long floats = (unsigned long) num_threads * (thread_floats + PLANNER_OPERATION_FLOATS) + shared_floats + PLANNER_FINAL_FLOATS;
+    return floats * memory_planner_float_bytes(precision_bits);
+}
+
+/*
+ * Bytes of the limit that are not used by the estimate (0 if there is no limit)
+ */
+unsigned long memory_planner_scratch(unsigned long estimate){
+    if(memory_limit == 0) return 0;
+    return (estimate < memory_limit) ? memory_limit - estimate : 1;
+}
+
+/*
+ * Refuses the execution if the estimate does not fit in the limit
+ */
+void memory_planner_check(char * algorithm_tag, unsigned long estimate){
+    memory_estimate = estimate;
+    if(memory_planner_fits(estimate)) return;
+    printf("  The estimated memory of %s (%lu MB) does not fit in the limit (%lu MB). \n", algorithm_tag, estimate >> 20, memory_limit >> 20);
+    printf("  Try using a lower precision, less threads or a greater limit. \n\n");
+    exit(-1);
+}
@@ -0,0 +1,13 @@
+#ifndef MEMORY_PLANNER
+#define MEMORY_PLANNER
+
+void memory_planner_set_limit(unsigned long);
+unsigned long memory_planner_get_limit();
+unsigned long memory_planner_get_estimate();
+int memory_planner_fits(unsigned long);
+unsigned long memory_planner_float_bytes(long);
+unsigned long memory_planner_estimate(long, int, int, int);
+unsigned long memory_planner_scratch(unsigned long);
+void memory_planner_check(char *, unsigned long);
+
+#endif
@@ -0,0 +1,191 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+
+#define NUMA_MAX_NODES 64
+#define NUMA_MAX_CPUS 1024
+#define NUMA_MPOL_DEFAULT 0             // Values of linux/mempolicy.h
+#define NUMA_MPOL_INTERLEAVE 3
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * NUMA mode: thread placement and memory policies                                  *
+ *                                                                                  *
+ ************************************************************************************
+ * The nodes and their cpus are read from /sys/devices/system/node and the memory   *
+ * policies are set with the set_mempolicy system call (libnuma is not needed)      *
+ *                                                                                  *
+ * The threads are split in one contiguous group per node and each thread is        *
+ * pinned to a cpu of its node. With 8 threads and 2 nodes:                         *
+ *                                                                                  *
+ *      node 0: threads 0 1 2 3        node 1: threads 4 5 6 7                      *
+ *                                                                                  *
+ * The threads are pinned before they initialize their variables, so the pages of   *
+ * their private state are allocated in their node (first touch). The tables that   *
+ * are shared by all the threads are interleaved among the nodes, and the           *
+ * reductions add the partial results of each node before crossing sockets.         *
+ * Without the NUMA mode all the threads form a single group                        *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int numa_enabled = 0;
+static int numa_num_nodes = 1;
+static int numa_node_ids[NUMA_MAX_NODES];
+static int numa_node_num_cpus[NUMA_MAX_NODES];
+static int * numa_node_cpus[NUMA_MAX_NODES];
+static unsigned long numa_all_nodes_mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long)) + 1];
+
+
+/*
+ * Parses a sysfs list like "0-3,8,10-11". Stores the values in values
+ * (up to max_values) and returns how many there are
+ */
+static int numa_parse_list(const char * list, int * values, int max_values){
+    int count = 0, first, last, i;
+    const char * p = list;
+    char * end;
+
+    while(*p >= '0' && *p <= '9'){
+        first = strtol(p, &end, 10);
+        last = first;
+        if(*end == '-') last = strtol(end + 1, &end, 10);
+        for(i = first; i <= last && count < max_values; i++) values[count++] = i;
+        if(*end != ',') break;
+        p = end + 1;
+    }
+    return count;
+}
+
+/*
+ * Reads a line of a sysfs file. Returns 0 if the file does not exist
+ */
+static int numa_read_sysfs(const char * path, char * buffer, int size){
+    FILE * file = fopen(path, "r");
+    if(file == NULL) return 0;
+    if(fgets(buffer, size, file) == NULL) buffer[0] = '\0';
+    fclose(file);
+    return 1;
+}
+
+/*
+ * Discovers the nodes and their cpus (only the cpus the process may use).
+ * If there is no information, a single node with all the cpus is used
+ */
+void numa_enable(){
+    char path[128], buffer[4096];
+    int nodes[NUMA_MAX_NODES], cpus[NUMA_MAX_CPUS];
+    int i, j, node_count, cpu_count, usable;
+    cpu_set_t allowed;
+
+    sched_getaffinity(0, sizeof(cpu_set_t), &allowed);
+    numa_num_nodes = 0;
+    if(numa_read_sysfs("/sys/devices/system/node/online", buffer, sizeof(buffer))){
+        node_count = numa_parse_list(buffer, nodes, NUMA_MAX_NODES);
+        for(i = 0; i < node_count; i++){
+            sprintf(path, "/sys/devices/system/node/node%d/cpulist", nodes[i]);
+            if(!numa_read_sysfs(path, buffer, sizeof(buffer))) continue;
+            cpu_count = numa_parse_list(buffer, cpus, NUMA_MAX_CPUS);
+
+            //Nodes without usable cpus (memory only nodes or cpusets) are skipped
+            numa_node_cpus[numa_num_nodes] = malloc(cpu_count * sizeof(int));
+            usable = 0;
+            for(j = 0; j < cpu_count; j++){
+                if(cpus[j] < CPU_SETSIZE && CPU_ISSET(cpus[j], &allowed)) numa_node_cpus[numa_num_nodes][usable++] = cpus[j];
+            }
+            if(usable == 0){
+                free(numa_node_cpus[numa_num_nodes]);
+                continue;
+            }
+            numa_node_ids[numa_num_nodes] = nodes[i];
+            numa_node_num_cpus[numa_num_nodes] = usable;
+            numa_all_nodes_mask[nodes[i] / (8 * sizeof(unsigned long))] |= 1UL << (nodes[i] % (8 * sizeof(unsigned long)));
+            numa_num_nodes++;
+        }
+    }
+
+    if(numa_num_nodes == 0){
+        numa_num_nodes = 1;
+        numa_node_ids[0] = 0;
+        numa_node_cpus[0] = malloc(CPU_COUNT(&allowed) * sizeof(int));
+        numa_node_num_cpus[0] = 0;
+        for(i = 0; i < CPU_SETSIZE; i++){
+            if(CPU_ISSET(i, &allowed)) numa_node_cpus[0][numa_node_num_cpus[0]++] = i;
+        }
+    }
+    numa_enabled = 1;
+}
+
+int numa_is_enabled(){
+    return numa_enabled;
+}
+
+/*
+ * Number of thread groups (one per node used)
+ */
+int numa_num_groups(int num_threads){
+    if(!numa_enabled) return 1;
+    return (numa_num_nodes < num_threads) ? numa_num_nodes : num_threads;
+}
+
+/*
+ * First thread of a group
+ */
+int numa_group_first_thread(int group, int num_threads){
+    return (int) ((long) group * num_threads / numa_num_groups(num_threads));
+}
+
+/*
+ * Group of a thread
+ */
+int numa_thread_group(int thread_id, int num_threads){
+    int group = numa_num_groups(num_threads) - 1;
+    while(numa_group_first_thread(group, num_threads) > thread_id) group--;
+    return group;
+}
+
+/*
+ * Threads of the biggest group
+ */
+int numa_max_group_size(int num_threads){
+    int groups = numa_num_groups(num_threads);
+    return (num_threads + groups - 1) / groups;
+}
+
+/*
+ * Pins the calling thread to a cpu of the node of its group.
+ * It does nothing without the NUMA mode
+ */
+void numa_bind_thread(int thread_id, int num_threads){
+    int group, node_thread;
+    cpu_set_t cpu;
+
+    if(!numa_enabled) return;
+    group = numa_thread_group(thread_id, num_threads);
+    node_thread = thread_id - numa_group_first_thread(group, num_threads);
+
+    CPU_ZERO(&cpu);
+    CPU_SET(numa_node_cpus[group][node_thread % numa_node_num_cpus[group]], &cpu);
+    sched_setaffinity(0, sizeof(cpu_set_t), &cpu);
+}
+
+/*
+ * The pages allocated by the calling thread from now on are interleaved among
+ * the nodes (used for the tables shared by all the threads)
+ */
+void numa_interleave_begin(){
+    if(!numa_enabled || numa_num_nodes < 2) return;
+    syscall(SYS_set_mempolicy, NUMA_MPOL_INTERLEAVE, numa_all_nodes_mask, NUMA_MAX_NODES + 1);
+}
+
+/*
+ * Restores the default policy (pages allocated in the node of the thread)
+ */
+void numa_interleave_end(){
+    if(!numa_enabled || numa_num_nodes < 2) return;
+    syscall(SYS_set_mempolicy, NUMA_MPOL_DEFAULT, NULL, 0);
+}
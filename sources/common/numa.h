@@ -0,0 +1,14 @@
+#ifndef NUMA
+#define NUMA
+
+void numa_enable();
+int numa_is_enabled();
+int numa_num_groups(int);
+int numa_group_first_thread(int, int);
+int numa_thread_group(int, int);
+int numa_max_group_size(int);
+void numa_bind_thread(int, int);
+void numa_interleave_begin();
+void numa_interleave_end();
+
+#endif
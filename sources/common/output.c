@@ -0,0 +1,113 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "output.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Output of the decimals of pi to a file (-o)                                      *
+ *                                                                                  *
+ ************************************************************************************
+ * The file is created when the parameters are read, so a wrong path is reported    *
+ * before the computation starts. pi is written as:                                 *
+ *                                                                                  *
+ *      3.14159265358979323846...                                                   *
+ *                                                                                  *
+ * The decimal string is never built as a whole: the conversion                     *
+ * (gmp/radix_conversion.c) produces chunks of decimals and each chunk is written   *
+ * with pwrite at its own offset (after the integer part), so the threads write     *
+ * their chunks in any order while the rest keep converting. The writeback of each  *
+ * chunk is started at once (sync_file_range), so the disk works while the next     *
+ * chunks are converted and the dirty pages do not pile up in memory                *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int output_fd = -1;
+static char * output_path = NULL;
+static off_t output_header_bytes = 0;       // Bytes of the integer part and the point
+static double output_write_time = 0;        // Seconds spent in the writes (all the threads)
+
+
+/*
+ * Creates the output file
+ */
+void output_enable(char * path){
+    output_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(output_fd < 0){
+        printf("  The output file %s can not be created \n\n", path);
+        exit(-1);
+    }
+    output_path = path;
+}
+
+int output_is_enabled(){
+    return output_fd >= 0;
+}
+
+char * output_get_path(){
+    return output_path;
+}
+
+double output_get_write_time(){
+    return output_write_time;
+}
+
+/*
+ * Writes bytes bytes of data at offset of the output file
+ */
+static void output_pwrite(const char * data, size_t bytes, off_t offset){
+    size_t done = 0;
+    ssize_t written;
+
+    while(done < bytes){
+        written = pwrite(output_fd, data + done, bytes - done, offset + done);
+        if(written <= 0){
+            printf("  The decimals can not be written in %s \n\n", output_path);
+            exit(-1);
+        }
+        done += written;
+    }
+}
+
+/*
+ * Writes the integer part of pi and the point
+ */
+void output_write_header(unsigned long integer_part){
+    char header[32];
+
+    output_header_bytes = snprintf(header, sizeof(header), "%lu.", integer_part);
+    output_pwrite(header, output_header_bytes, 0);
+}
+
+/*
+ * Writes length decimals starting at the decimal offset (0 is the first one).
+ * It can be called by several threads at the same time
+ */
+void output_write_digits(long offset, char * digits, long length){
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    output_pwrite(digits, length, output_header_bytes + offset);
+    sync_file_range(output_fd, output_header_bytes + offset, length, SYNC_FILE_RANGE_WRITE);
+    gettimeofday(&t2, NULL);
+
+    #pragma omp atomic
+    output_write_time += ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6;
+}
+
+/*
+ * Ends the file after decimals decimals and closes it
+ */
+void output_close(long decimals){
+    output_pwrite("\n", 1, output_header_bytes + decimals);
+    if(close(output_fd) != 0){
+        printf("  The decimals can not be written in %s \n\n", output_path);
+        exit(-1);
+    }
+    output_fd = -1;
+}
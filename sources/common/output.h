@@ -0,0 +1,12 @@
+#ifndef OUTPUT
+#define OUTPUT
+
+void output_enable(char *);
+int output_is_enabled();
+char * output_get_path();
+double output_get_write_time();
+void output_write_header(unsigned long);
+void output_write_digits(long, char *, long);
+void output_close(long);
+
+#endif
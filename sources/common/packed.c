@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "packed.h"
+
+
+#define PACKED_MAGIC "PIPACK19"
+#define PACKED_BLOCK_WORDS 65536        // Blocks of 512 KB (1245184 decimals)
+#define PACKED_ALIGNMENT 64
+#define PACKED_FNV_OFFSET 14695981039346656037UL
+#define PACKED_FNV_PRIME 1099511628211UL
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Packed binary format of the decimals of pi (-packed) and random access to it     *
+ * (-lookup)                                                                        *
+ *                                                                                  *
+ ************************************************************************************
+ * The decimals are stored in 64 bits words of 19 decimals (base 10^19), 8 bytes    *
+ * for 19 decimals instead of 19 bytes of text (2.4 times smaller):                 *
+ *                                                                                  *
+ *      | header | block index | words (block 0) | words (block 1) | ...            *
+ *                                                                                  *
+ * The header has the algorithm, the precision, the decimals and the integer part.  *
+ * The word w holds the decimals [19 w, 19 w + 19) (the first decimal is the most   *
+ * significant digit), so the word of any decimal is found with a division. The     *
+ * words are grouped in blocks of 65536 and the index keeps the offset and the      *
+ * checksum (FNV-1a of the words) of each block.                                    *
+ *                                                                                  *
+ * The file is written through a shared mapping: the chunks of the conversion       *
+ * (gmp/radix_conversion.c) are packed by the threads in any order. A word split    *
+ * between two chunks gets the part of each chunk with an atomic add (the mapping   *
+ * starts with zeros). The checksums are computed in parallel when every chunk is   *
+ * packed. A range of decimals is read from the mapping of the file, checking the   *
+ * checksums of the blocks it touches, without reading the rest of the file         *
+ *                                                                                  *
+ ************************************************************************************/
+
+static const uint64_t powers_of_10[PACKED_WORD_DIGITS + 1] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+    10000000000UL, 100000000000UL, 1000000000000UL, 10000000000000UL, 100000000000000UL,
+    1000000000000000UL, 10000000000000000UL, 100000000000000000UL, 1000000000000000000UL,
+    10000000000000000000UL
+};
+
+static int packed_fd = -1;
+static char * packed_path = NULL;
+static unsigned char * packed_map = NULL;
+static size_t packed_bytes = 0;
+static uint64_t * packed_words = NULL;
+
+
+/*
+ * Creates the packed file
+ */
+void packed_enable(char * path){
+    packed_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(packed_fd < 0){
+        printf("  The packed file %s can not be created \n\n", path);
+        exit(-1);
+    }
+    packed_path = path;
+}
+
+int packed_is_enabled(){
+    return packed_fd >= 0;
+}
+
+char * packed_get_path(){
+    return packed_path;
+}
+
+unsigned long packed_get_bytes(){
+    return packed_bytes;
+}
+
+/*
+ * Checksum of num_words words (FNV-1a, a word at a time)
+ */
+static uint64_t packed_checksum(const uint64_t * words, uint64_t num_words){
+    uint64_t checksum = PACKED_FNV_OFFSET, i;
+
+    for(i = 0; i < num_words; i++){
+        checksum ^= words[i];
+        checksum *= PACKED_FNV_PRIME;
+    }
+    return checksum;
+}
+
+/*
+ * Words of the block block of a file with num_words words
+ */
+static uint64_t packed_block_words(uint64_t block, uint64_t num_words){
+    uint64_t block_end = (block + 1) * PACKED_BLOCK_WORDS;
+
+    return ((block_end < num_words) ? block_end : num_words) - block * PACKED_BLOCK_WORDS;
+}
+
+/*
+ * Sizes the packed file for decimals decimals and writes its header
+ */
+void packed_begin(char * algorithm_tag, long precision, unsigned long integer_part, long decimals){
+    uint64_t num_words = (decimals + PACKED_WORD_DIGITS - 1) / PACKED_WORD_DIGITS;
+    uint64_t num_blocks = (num_words + PACKED_BLOCK_WORDS - 1) / PACKED_BLOCK_WORDS;
+    uint64_t index_offset = sizeof(packed_header);
+    uint64_t words_offset = (index_offset + num_blocks * sizeof(packed_block) + PACKED_ALIGNMENT - 1) & ~((uint64_t) PACKED_ALIGNMENT - 1);
+    packed_header * header;
+
+    packed_bytes = words_offset + num_words * sizeof(uint64_t);
+    if(ftruncate(packed_fd, packed_bytes) != 0){
+        printf("  The packed file %s can not be sized to %zu bytes \n\n", packed_path, packed_bytes);
+        exit(-1);
+    }
+    packed_map = mmap(NULL, packed_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, packed_fd, 0);
+    if(packed_map == MAP_FAILED){
+        printf("  The packed file %s can not be mapped \n\n", packed_path);
+        exit(-1);
+    }
+
+    header = (packed_header *) packed_map;
+    memcpy(header -> magic, PACKED_MAGIC, sizeof(header -> magic));
+    strncpy(header -> algorithm_tag, algorithm_tag, PACKED_TAG_BYTES - 1);
+    header -> precision = precision;
+    header -> decimals = decimals;
+    header -> integer_part = integer_part;
+    header -> block_words = PACKED_BLOCK_WORDS;
+    header -> num_blocks = num_blocks;
+    header -> index_offset = index_offset;
+    header -> words_offset = words_offset;
+    packed_words = (uint64_t *) (packed_map + words_offset);
+}
+
+/*
+ * Packs length decimals starting at the decimal offset (0 is the first one).
+ * It can be called by several threads at the same time
+ */
+void packed_write_digits(long offset, char * digits, long length){
+    long word, first_word = offset / PACKED_WORD_DIGITS, last_word = (offset + length - 1) / PACKED_WORD_DIGITS;
+    long start, end, i;
+    uint64_t value;
+
+    for(word = first_word; word <= last_word; word++){
+        start = word * PACKED_WORD_DIGITS;
+        end = start + PACKED_WORD_DIGITS;
+        if(start < offset) start = offset;
+        if(end > offset + length) end = offset + length;
+
+        value = 0;
+        for(i = start; i < end; i++){
+            value = value * 10 + (digits[i - offset] - '0');
+        }
+        value *= powers_of_10[(word + 1) * PACKED_WORD_DIGITS - end];
+
+        if(end - start == PACKED_WORD_DIGITS){
+            packed_words[word] = value;
+        } else {
+            //The rest of the word belongs to the next or the previous chunk
+            #pragma omp atomic
+            packed_words[word] += value;
+        }
+    }
+}
+
+/*
+ * Writes the block index (with num_threads threads) and closes the packed file
+ */
+void packed_end(int num_threads){
+    packed_header * header = (packed_header *) packed_map;
+    packed_block * index = (packed_block *) (packed_map + header -> index_offset);
+    uint64_t num_words = (header -> decimals + PACKED_WORD_DIGITS - 1) / PACKED_WORD_DIGITS;
+    long block;
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for(block = 0; block < (long) header -> num_blocks; block++){
+        index[block].offset = header -> words_offset + block * PACKED_BLOCK_WORDS * sizeof(uint64_t);
+        index[block].checksum = packed_checksum(packed_words + block * PACKED_BLOCK_WORDS, packed_block_words(block, num_words));
+    }
+
+    if(msync(packed_map, packed_bytes, MS_SYNC) != 0 || munmap(packed_map, packed_bytes) != 0 || close(packed_fd) != 0){
+        printf("  The decimals can not be written in %s \n\n", packed_path);
+        exit(-1);
+    }
+    packed_map = NULL;
+    packed_words = NULL;
+    packed_fd = -1;
+}
+
+/*
+ * Maps the packed file path and checks its header
+ */
+void packed_open(packed_file * file, char * path){
+    struct stat status;
+    const packed_header * header;
+    uint64_t num_words;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0 || fstat(fd, &status) != 0){
+        printf("  The packed file %s can not be opened \n\n", path);
+        exit(-1);
+    }
+    if((size_t) status.st_size < sizeof(packed_header)){
+        printf("  %s is not a packed file of decimals \n\n", path);
+        exit(-1);
+    }
+    file -> bytes = status.st_size;
+    file -> map = mmap(NULL, file -> bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(file -> map == MAP_FAILED){
+        printf("  The packed file %s can not be mapped \n\n", path);
+        exit(-1);
+    }
+    madvise((void *) file -> map, file -> bytes, MADV_RANDOM);
+
+    header = (const packed_header *) file -> map;
+    num_words = (header -> decimals + PACKED_WORD_DIGITS - 1) / PACKED_WORD_DIGITS;
+    if(memcmp(header -> magic, PACKED_MAGIC, sizeof(header -> magic)) != 0 || header -> block_words != PACKED_BLOCK_WORDS
+       || header -> num_blocks != (num_words + PACKED_BLOCK_WORDS - 1) / PACKED_BLOCK_WORDS
+       || header -> index_offset + header -> num_blocks * sizeof(packed_block) > header -> words_offset
+       || header -> words_offset + num_words * sizeof(uint64_t) > file -> bytes){
+        printf("  %s is not a packed file of decimals \n\n", path);
+        exit(-1);
+    }
+    file -> header = header;
+    file -> index = (const packed_block *) (file -> map + header -> index_offset);
+    file -> words = (const uint64_t *) (file -> map + header -> words_offset);
+    file -> path = path;
+}
+
+/*
+ * Reads the decimals [first, last) of the packed file in digits (without going further
+ * than the decimals of the file) and returns the number of decimals read. The checksums
+ * of the blocks touched are checked
+ */
+long packed_read(packed_file * file, long first, long last, char * digits){
+    uint64_t num_words = (file -> header -> decimals + PACKED_WORD_DIGITS - 1) / PACKED_WORD_DIGITS;
+    uint64_t block, value;
+    long word, start, end;
+    char text[PACKED_WORD_DIGITS];
+    int i;
+
+    if(last > (long) file -> header -> decimals) last = file -> header -> decimals;
+    if(first < 0) first = 0;
+    if(first >= last) return 0;
+
+    for(block = first / PACKED_WORD_DIGITS / PACKED_BLOCK_WORDS; block <= (uint64_t) (last - 1) / PACKED_WORD_DIGITS / PACKED_BLOCK_WORDS; block++){
+        if(packed_checksum(file -> words + block * PACKED_BLOCK_WORDS, packed_block_words(block, num_words)) != file -> index[block].checksum){
+            printf("  The block %lu of %s is corrupted \n\n", block, file -> path);
+            exit(-1);
+        }
+    }
+
+    for(word = first / PACKED_WORD_DIGITS; word <= (last - 1) / PACKED_WORD_DIGITS; word++){
+        value = file -> words[word];
+        for(i = PACKED_WORD_DIGITS - 1; i >= 0; i--){
+            text[i] = '0' + value % 10;
+            value /= 10;
+        }
+        start = (word * PACKED_WORD_DIGITS < first) ? first : word * PACKED_WORD_DIGITS;
+        end = ((word + 1) * PACKED_WORD_DIGITS > last) ? last : (word + 1) * PACKED_WORD_DIGITS;
+        memcpy(digits + start - first, text + start - word * PACKED_WORD_DIGITS, end - start);
+    }
+    return last - first;
+}
+
+void packed_close(packed_file * file){
+    munmap((void *) file -> map, file -> bytes);
+}
+
+/*
+ * Prints the decimals [first, last) of the packed file path (-lookup)
+ */
+void packed_lookup(char * path, long first, long last){
+    packed_file file;
+    char * digits;
+    long length;
+
+    packed_open(&file, path);
+    if(first < 0 || last <= first || last > (long) file.header -> decimals){
+        printf("  The range should be inside [0, %lu) \n\n", file.header -> decimals);
+        exit(-1);
+    }
+    digits = malloc(last - first);
+    if(digits == NULL){
+        printf("Not enough memory to read the decimals \n");
+        exit(-1);
+    }
+    length = packed_read(&file, first, last, digits);
+    fwrite(digits, 1, length, stdout);
+    printf("\n");
+
+    free(digits);
+    packed_close(&file);
+}
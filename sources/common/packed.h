@@ -0,0 +1,48 @@
+#ifndef PACKED
+#define PACKED
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PACKED_WORD_DIGITS 19           // Decimals of each word (10^19 < 2^64)
+#define PACKED_TAG_BYTES 32
+
+typedef struct {
+    char magic[8];                      // "PIPACK19"
+    char algorithm_tag[PACKED_TAG_BYTES];
+    uint64_t precision;                 // Precision of the execution
+    uint64_t decimals;                  // Decimals stored
+    uint64_t integer_part;
+    uint64_t block_words;               // Words of each block (the last one may be shorter)
+    uint64_t num_blocks;
+    uint64_t index_offset;              // Bytes from the start of the file to the block index
+    uint64_t words_offset;              // Bytes from the start of the file to the words
+} packed_header;
+
+typedef struct {
+    uint64_t offset;                    // Bytes from the start of the file to the block
+    uint64_t checksum;                  // FNV-1a of the words of the block
+} packed_block;
+
+typedef struct {
+    const unsigned char * map;
+    size_t bytes;
+    const packed_header * header;
+    const packed_block * index;
+    const uint64_t * words;
+    char * path;
+} packed_file;
+
+void packed_enable(char *);
+int packed_is_enabled();
+char * packed_get_path();
+unsigned long packed_get_bytes();
+void packed_begin(char *, long, unsigned long, long);
+void packed_write_digits(long, char *, long);
+void packed_end(int);
+void packed_open(packed_file *, char *);
+long packed_read(packed_file *, long, long, char *);
+void packed_close(packed_file *);
+void packed_lookup(char *, long, long);
+
+#endif
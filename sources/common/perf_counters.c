@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "perf_counters.h"
+#include "phase_timers.h"
+
+
+#define COUNTERS_MAX_THREADS 256
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Hardware counters of each phase of each thread with perf_event_open (-counters)  *
+ *                                                                                  *
+ ************************************************************************************
+ * When a thread starts its phase timers it opens its own counters (pid 0, any      *
+ * cpu: they count the thread wherever it runs, only in user mode):                 *
+ *                                                                                  *
+ *      cycles, instructions, LLC misses (cache misses of the last level),          *
+ *      branch misses, dTLB misses (loads)                                          *
+ *                                                                                  *
+ * Each lap of the phase timers reads them and adds the difference to the phase,    *
+ * so the series of GMP-CHD-SME-BLC and GMP-CHD-SME-INT-BLC can be compared by      *
+ * IPC (instructions / cycles) and misses per kilo instruction.                     *
+ *                                                                                  *
+ * The counters are opened as one group, so the kernel schedules them together and  *
+ * one read gives all of them. The first counter opened is the leader: a counter    *
+ * that the CPU does not have is left out of the group (-1) and the others are      *
+ * still counted. If the kernel does not allow them (perf_event_paranoid,           *
+ * containers, virtual machines) the execution goes on and the reason is reported.  *
+ *                                                                                  *
+ * When there are more counters than registers the kernel multiplexes the group.    *
+ * The raw values and the times enabled and running are kept, and the difference    *
+ * of each lap is scaled by the times of that lap:                                  *
+ *                                                                                  *
+ *      events = delta(value) * delta(enabled) / delta(running)                     *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    int opened;                         // The fds are open (the previous execution is closed at start)
+    int leader;                         // fd of the leader of the group (-1 if no counter could be opened)
+    int fds[COUNTERS_NUM];
+    int slots[COUNTERS_NUM];            // Position of each counter in the read of the group (-1 if left out)
+    int num_events;
+    uint64_t last[COUNTERS_NUM];        // Raw values of the previous lap
+    uint64_t last_enabled;
+    uint64_t last_running;
+    uint64_t counts[TIMERS_NUM_PHASES][COUNTERS_NUM];
+} __attribute__((aligned(64))) thread_counters;
+
+static int counters_enabled = 0;
+static int counters_opened = 0;
+static int counters_error = 0;
+static thread_counters counters[COUNTERS_MAX_THREADS];
+
+static const uint32_t counter_types[COUNTERS_NUM] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+};
+static const uint64_t counter_configs[COUNTERS_NUM] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+};
+
+
+void perf_counters_enable(){
+    counters_enabled = 1;
+}
+
+int perf_counters_is_enabled(){
+    return counters_enabled;
+}
+
+/*
+ * Opens a counter of the calling thread in the group of leader (-1 starts a new group).
+ * Returns -1 if it can not be opened
+ */
+static int perf_counters_open(int counter, int leader){
+    struct perf_event_attr attributes;
+    int fd;
+
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = counter_types[counter];
+    attributes.config = counter_configs[counter];
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    fd = syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0);
+    if(fd < 0){
+        #pragma omp critical(perf_counters)
+        {
+            if(counters_error == 0) counters_error = errno;
+        }
+    }
+    return fd;
+}
+
+/*
+ * Raw values of the group of the thread (in the order the counters were opened) and
+ * its times enabled and running. Returns 0 if it can not be read
+ */
+static int perf_counters_read(thread_counters * thread, uint64_t * values, uint64_t * enabled, uint64_t * running){
+    uint64_t buffer[3 + COUNTERS_NUM];  // number of values, time enabled, time running, values
+    long bytes = (3 + thread -> num_events) * sizeof(uint64_t);
+
+    if(read(thread -> leader, buffer, bytes) != bytes || buffer[0] != (uint64_t) thread -> num_events) return 0;
+    *enabled = buffer[1];
+    *running = buffer[2];
+    memcpy(values, &buffer[3], thread -> num_events * sizeof(uint64_t));
+    return 1;
+}
+
+static void perf_counters_close(thread_counters * thread){
+    int counter;
+
+    for(counter = 0; thread -> opened && counter < COUNTERS_NUM; counter++){
+        if(thread -> fds[counter] >= 0) close(thread -> fds[counter]);
+    }
+    thread -> opened = 0;
+}
+
+/*
+ * Called by each thread when it starts its phase timers: the counters of a previous
+ * execution are closed and a new group is opened
+ */
+void perf_counters_start(int thread_id){
+    thread_counters * thread;
+    int counter;
+
+    if(!counters_enabled || thread_id >= COUNTERS_MAX_THREADS) return;
+
+    thread = &counters[thread_id];
+    perf_counters_close(thread);
+    memset(thread, 0, sizeof(thread_counters));
+    thread -> opened = 1;
+    thread -> leader = -1;
+    for(counter = 0; counter < COUNTERS_NUM; counter++){
+        thread -> fds[counter] = perf_counters_open(counter, thread -> leader);
+        thread -> slots[counter] = (thread -> fds[counter] >= 0) ? thread -> num_events++ : -1;
+        if(thread -> leader < 0) thread -> leader = thread -> fds[counter];
+    }
+    if(thread -> num_events > 0 && !perf_counters_read(thread, thread -> last, &thread -> last_enabled, &thread -> last_running)){
+        #pragma omp critical(perf_counters)
+        {
+            if(counters_error == 0) counters_error = errno;
+        }
+        perf_counters_close(thread);
+        return;
+    }
+    #pragma omp critical(perf_counters)
+    {
+        counters_opened += thread -> num_events;
+    }
+}
+
+/*
+ * Adds the events since the previous lap of the thread to phase
+ */
+void perf_counters_lap(int thread_id, int phase){
+    thread_counters * thread;
+    uint64_t values[COUNTERS_NUM], enabled, running, delta;
+    int counter, slot;
+
+    if(!counters_enabled || thread_id >= COUNTERS_MAX_THREADS) return;
+
+    thread = &counters[thread_id];
+    if(!thread -> opened || thread -> num_events == 0 || !perf_counters_read(thread, values, &enabled, &running)) return;
+
+    for(counter = 0; counter < COUNTERS_NUM; counter++){
+        slot = thread -> slots[counter];
+        if(slot < 0) continue;
+        delta = values[slot] - thread -> last[slot];
+        //Scaled by the times of this lap when the group has been multiplexed (not counted if it did not run)
+        if(running - thread -> last_running == 0){
+            delta = 0;
+        } else if(running - thread -> last_running < enabled - thread -> last_enabled){
+            delta = (uint64_t) ((double) delta * (enabled - thread -> last_enabled) / (running - thread -> last_running));
+        }
+        thread -> counts[phase][counter] += delta;
+    }
+    memcpy(thread -> last, values, thread -> num_events * sizeof(uint64_t));
+    thread -> last_enabled = enabled;
+    thread -> last_running = running;
+}
+
+/*
+ * Number of counters opened by the threads. If it is 0, reason points to the error
+ * of the first one
+ */
+int perf_counters_available(char ** reason){
+    if(counters_error == EACCES || counters_error == EPERM){
+        *reason = "not permitted (see /proc/sys/kernel/perf_event_paranoid)";
+    } else if(counters_error == ENOENT || counters_error == EOPNOTSUPP){
+        *reason = "not supported by this CPU or virtual machine";
+    } else if(counters_error == ENOSYS){
+        *reason = "perf_event_open is not available in this kernel";
+    } else {
+        *reason = strerror(counters_error);
+    }
+    return counters_opened;
+}
+
+/*
+ * Copies the counters (values[(thread * TIMERS_NUM_PHASES + phase) * COUNTERS_NUM + counter],
+ * -1 if the counter could not be opened) of num_threads threads and closes them
+ */
+void perf_counters_get(long * values, int num_threads){
+    int i, phase, counter;
+
+    for(i = 0; i < num_threads && i < COUNTERS_MAX_THREADS; i++){
+        for(phase = 0; phase < TIMERS_NUM_PHASES; phase++){
+            for(counter = 0; counter < COUNTERS_NUM; counter++){
+                values[(i * TIMERS_NUM_PHASES + phase) * COUNTERS_NUM + counter] =
+                    (counters[i].opened && counters[i].slots[counter] >= 0) ? (long) counters[i].counts[phase][counter] : -1;
+            }
+        }
+        perf_counters_close(&counters[i]);
+    }
+}
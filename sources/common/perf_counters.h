@@ -0,0 +1,18 @@
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS
+
+#define COUNTERS_NUM 5
+#define COUNTER_CYCLES 0
+#define COUNTER_INSTRUCTIONS 1
+#define COUNTER_LLC_MISSES 2
+#define COUNTER_BRANCH_MISSES 3
+#define COUNTER_DTLB_MISSES 4
+
+void perf_counters_enable();
+int perf_counters_is_enabled();
+void perf_counters_start(int);
+void perf_counters_lap(int, int);
+int perf_counters_available(char **);
+void perf_counters_get(long *, int);
+
+#endif
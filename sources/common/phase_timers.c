@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "phase_timers.h"
+#include "perf_counters.h"
+
+
+#define TIMERS_MAX_THREADS 256
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Per-thread phase timers and load imbalance (-phases)                             *
+ *                                                                                  *
+ ************************************************************************************
+ * Each thread of an engine takes a timestamp when it starts and a lap at the end   *
+ * of each phase: the time since the previous lap (wall and CPU of the thread) is   *
+ * added to the phase.                                                              *
+ *                                                                                  *
+ *      start | seed | series | reduction | wait | reduction | wait | ...           *
+ *                                                                                  *
+ * The engines lap the seed (dependencies of the first term) and the series, and    *
+ * the tree reductions lap the time spent at each barrier as wait. The first        *
+ * barrier is where the threads that finish early wait for the slowest one, so      *
+ * the wait shows the partitioning and the series the arithmetic:                   *
+ *                                                                                  *
+ *      imbalance = max(seed + series) / mean(seed + series)                        *
+ *      idle = sum(wait) / sum(seed + series + wait + reduction)                    *
+ *                                                                                  *
+ * The CPU time of a thread lower than its wall time means that it was descheduled  *
+ * (more threads than cores). The OpenMP threads may spin at the barriers, so the   *
+ * CPU time of the wait is not idle for the machine. The task of the constant of    *
+ * Chudnovsky runs at a barrier when no thread has taken it before, so it may be    *
+ * counted as wait                                                                  *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    double wall[TIMERS_NUM_PHASES];
+    double cpu[TIMERS_NUM_PHASES];
+    double last_wall;
+    double last_cpu;
+    char padding[48];                   // Each thread writes its own cache lines
+} thread_timers;
+
+static int timers_enabled = 0;
+static int timers_threads = 0;
+static thread_timers timers[TIMERS_MAX_THREADS] __attribute__((aligned(64)));
+
+
+static double phase_timers_clock(clockid_t clock){
+    struct timespec now;
+
+    clock_gettime(clock, &now);
+    return now.tv_sec + now.tv_nsec / 1.e9;
+}
+
+void phase_timers_enable(){
+    timers_enabled = 1;
+}
+
+int phase_timers_is_enabled(){
+    return timers_enabled;
+}
+
+/*
+ * Called before the engine: the timers of the previous execution are discarded
+ */
+void phase_timers_begin(){
+    timers_threads = 0;
+}
+
+/*
+ * Called by each thread when it starts its work
+ */
+void phase_timers_start(int thread_id){
+    if(!timers_enabled || thread_id >= TIMERS_MAX_THREADS) return;
+
+    //The counters are opened before the timestamps (-counters)
+    perf_counters_start(thread_id);
+    memset(&timers[thread_id], 0, sizeof(thread_timers));
+    timers[thread_id].last_wall = phase_timers_clock(CLOCK_MONOTONIC);
+    timers[thread_id].last_cpu = phase_timers_clock(CLOCK_THREAD_CPUTIME_ID);
+    #pragma omp critical(phase_timers)
+    {
+        if(thread_id >= timers_threads) timers_threads = thread_id + 1;
+    }
+}
+
+/*
+ * Adds the time since the previous lap of the thread to phase
+ */
+void phase_timers_lap(int thread_id, int phase){
+    double wall, cpu;
+
+    if(!timers_enabled || thread_id >= TIMERS_MAX_THREADS) return;
+
+    wall = phase_timers_clock(CLOCK_MONOTONIC);
+    cpu = phase_timers_clock(CLOCK_THREAD_CPUTIME_ID);
+    timers[thread_id].wall[phase] += wall - timers[thread_id].last_wall;
+    timers[thread_id].cpu[phase] += cpu - timers[thread_id].last_cpu;
+    timers[thread_id].last_wall = wall;
+    timers[thread_id].last_cpu = cpu;
+    perf_counters_lap(thread_id, phase);
+}
+
+/*
+ * Copies the wall time of each phase (phase_times[thread * TIMERS_NUM_PHASES + phase]) and
+ * the CPU time of the threads timed (at most max_threads), and returns how many they are
+ */
+int phase_timers_get_stats(double * phase_times, double * cpu_times, double * imbalance, double * idle_fraction, int max_threads){
+    double work, max_work = 0, sum_work = 0, sum_wait = 0, sum_total = 0;
+    int num_threads = (timers_threads < max_threads) ? timers_threads : max_threads;
+    int i, phase;
+
+    for(i = 0; i < num_threads; i++){
+        cpu_times[i] = 0;
+        for(phase = 0; phase < TIMERS_NUM_PHASES; phase++){
+            phase_times[i * TIMERS_NUM_PHASES + phase] = timers[i].wall[phase];
+            cpu_times[i] += timers[i].cpu[phase];
+            sum_total += timers[i].wall[phase];
+        }
+        work = timers[i].wall[TIMERS_PHASE_SEED] + timers[i].wall[TIMERS_PHASE_SERIES];
+        if(work > max_work) max_work = work;
+        sum_work += work;
+        sum_wait += timers[i].wall[TIMERS_PHASE_WAIT];
+    }
+    *imbalance = (sum_work > 0) ? max_work * num_threads / sum_work : 0;
+    *idle_fraction = (sum_total > 0) ? sum_wait / sum_total : 0;
+    return num_threads;
+}
@@ -0,0 +1,17 @@
+#ifndef PHASE_TIMERS
+#define PHASE_TIMERS
+
+#define TIMERS_NUM_PHASES 4
+#define TIMERS_PHASE_SEED 0             // Dependencies of the first term of the thread (gmp_init_dep_a, powers...)
+#define TIMERS_PHASE_SERIES 1           // Terms of the series
+#define TIMERS_PHASE_WAIT 2             // Waiting at the barriers of the reduction
+#define TIMERS_PHASE_REDUCTION 3        // Additions of the reduction
+
+void phase_timers_enable();
+int phase_timers_is_enabled();
+void phase_timers_begin();
+void phase_timers_start(int);
+void phase_timers_lap(int, int);
+int phase_timers_get_stats(double *, double *, double *, double *, int);
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
+#include "verification.h"
 
 void replace_decimal_point_by_coma(double number, char *result){
     int i;
@@ -30,7 +32,7 @@ void print_title() {
     fclose(file);
 }
 
-void check_errors(int precision, int num_iterations, int num_threads){
+void check_errors(long precision, long num_iterations, int num_threads){
     if (precision <= 0){
         printf("  Precision should be greater than cero. \n\n");
         exit(-1);
@@ -42,28 +44,313 @@ void check_errors(int precision, int num_iterations, int num_threads){
     }
 }
 
-void print_results(char *library, char *algorithm_tag, int precision, int num_iterations, int num_threads, int decimals_computed, double execution_time) {
+void print_results(char *library, char *algorithm_tag, long precision, long num_iterations, int num_threads, long decimals_computed, double execution_time) {
     printf("  Library used: %s \n", library);
     printf("  Algorithm: %s \n", algorithm_tag);
-    printf("  Precision used: %d \n", precision);
-    printf("  Number of iterations: %d \n", num_iterations);
+    printf("  Precision used: %ld \n", precision);
+    printf("  Number of iterations: %ld \n", num_iterations);
     printf("  Number of threads: %d \n", num_threads);
-    if (decimals_computed >= precision) { printf("  Correct decimals: %d \n", decimals_computed); } 
-    else { printf("  Something went wrong. The execution just achieved %d decimals \n", decimals_computed); }
+    if (decimals_computed >= precision) { printf("  Correct decimals: %ld \n", decimals_computed); } 
+    else if (decimals_computed >= verification_reference_decimals()) { printf("  Correct decimals: %ld (the whole reference, the rest can not be checked) \n", decimals_computed); }
+    else { printf("  Something went wrong. The execution just achieved %ld decimals \n", decimals_computed); }
     printf("  Execution time: %f seconds \n", execution_time);
     printf("\n");
 }
 
-void print_results_csv(char *library, char *algorithm_tag, int precision, int num_iterations, int num_threads, int decimals_computed, double execution_time) {
+void print_results_csv(char *library, char *algorithm_tag, long precision, long num_iterations, int num_threads, long decimals_computed, double execution_time) {
     //char execution_time_string[100];
     //replace_decimal_point_by_coma(execution_time, execution_time_string);
     printf("OMP;");
     printf("%s;", library);
     printf("%s;", algorithm_tag);
-    printf("%d;", precision);
-    printf("%d;", num_iterations);
+    printf("%ld;", precision);
+    printf("%ld;", num_iterations);
     printf("%d;", num_threads);
-    printf("%d;", decimals_computed);
-    printf("%f;\n", execution_time);
+    printf("%ld;", decimals_computed);
+    printf("%f;", execution_time);
 }
 
+void print_memory_allocator_stats(unsigned long allocations, unsigned long reallocations, unsigned long frees, unsigned long reused) {
+    printf("  Allocations: %lu \n", allocations);
+    printf("  Blocks served from the thread pools: %lu \n", reused);
+    printf("  Reallocations: %lu \n", reallocations);
+    printf("  Frees: %lu \n", frees);
+    printf("\n");
+}
+
+void print_memory_allocator_stats_csv(unsigned long allocations, unsigned long reallocations, unsigned long frees, unsigned long reused) {
+    printf("%lu;", allocations);
+    printf("%lu;", reused);
+    printf("%lu;", reallocations);
+    printf("%lu;", frees);
+}
+
+void print_memory_accounting(unsigned long peak, long live, unsigned long * phase_peaks, unsigned long * phase_counts,
+                             unsigned long * thread_peaks, unsigned long * thread_counts, int num_threads,
+                             unsigned long estimate, unsigned long limit) {
+    char *phases[] = {"series", "reduction", "final"};
+    int i;
+
+    printf("  Peak memory: %.2f MB (%.2f MB live at the end) \n", peak / 1048576.0, live / 1048576.0);
+    if (limit > 0) {
+        printf("  Memory limit: %.2f MB (estimated %.2f MB) \n", limit / 1048576.0, estimate / 1048576.0);
+    }
+    for (i = 0; i < 3; i++) {
+        printf("  Phase %-9s -> peak: %.2f MB, allocations: %lu \n", phases[i], phase_peaks[i] / 1048576.0, phase_counts[i]);
+    }
+    for (i = 0; i < num_threads; i++) {
+        printf("  Thread %-3d -> peak: %.2f MB, allocations: %lu \n", i, thread_peaks[i] / 1048576.0, thread_counts[i]);
+    }
+    printf("\n");
+}
+
+void print_memory_accounting_csv(unsigned long peak, long live, unsigned long * phase_peaks, unsigned long * phase_counts,
+                                 unsigned long * thread_peaks, unsigned long * thread_counts, int num_threads,
+                                 unsigned long estimate, unsigned long limit) {
+    int i;
+
+    printf("%lu;", peak);
+    printf("%ld;", live);
+    printf("%lu;", estimate);
+    printf("%lu;", limit);
+    for (i = 0; i < 3; i++) {
+        printf("%lu;%lu;", phase_peaks[i], phase_counts[i]);
+    }
+    //The peaks of the threads are a single field: peak_0/peak_1/...
+    for (i = 0; i < num_threads; i++) {
+        printf((i + 1 < num_threads) ? "%lu/" : "%lu;", thread_peaks[i]);
+    }
+}
+
+void print_huge_page_stats(unsigned long explicit_bytes, unsigned long transparent_bytes, unsigned long mappings) {
+    printf("  Blocks mapped with huge pages: %lu \n", mappings);
+    printf("  Peak memory on explicit huge pages: %.2f MB \n", explicit_bytes / 1048576.0);
+    printf("  Peak memory on transparent huge pages: %.2f MB \n", transparent_bytes / 1048576.0);
+    printf("\n");
+}
+
+void print_huge_page_stats_csv(unsigned long explicit_bytes, unsigned long transparent_bytes, unsigned long mappings) {
+    printf("%lu;", mappings);
+    printf("%lu;", explicit_bytes);
+    printf("%lu;", transparent_bytes);
+}
+
+void print_output_stats(char * path, long decimals, double output_time, double write_time) {
+    printf("  Decimals written to %s: %ld \n", path, decimals);
+    printf("  Conversion and write time: %f seconds \n", output_time);
+    printf("  Time of the threads writing (overlapped with the conversion): %f seconds \n", write_time);
+    printf("\n");
+}
+
+void print_output_stats_csv(char * path, long decimals, double output_time, double write_time) {
+    printf("%ld;", decimals);
+    printf("%f;", output_time);
+    printf("%f;", write_time);
+}
+
+void print_packed_stats(char * path, long decimals, double packed_time, unsigned long bytes) {
+    printf("  Decimals packed in %s: %ld \n", path, decimals);
+    printf("  Conversion and pack time: %f seconds \n", packed_time);
+    printf("  Size of the packed file: %.2f MB (%.2f bytes per decimal) \n", bytes / 1048576.0, (decimals > 0) ? (double) bytes / decimals : 0.0);
+    printf("\n");
+}
+
+void print_packed_stats_csv(char * path, long decimals, double packed_time, unsigned long bytes) {
+    printf("%ld;", decimals);
+    printf("%f;", packed_time);
+    printf("%lu;", bytes);
+}
+
+void print_hex_verification_stats(long verified_decimals, int matches, int num_positions, double verification_time) {
+    printf("  Hex positions checked with BBP digit extraction: %d (%d match) \n", num_positions, matches);
+    printf("  Verified decimals (without reference): %ld \n", verified_decimals);
+    printf("  Verification time: %f seconds \n", verification_time);
+    printf("\n");
+}
+
+void print_hex_verification_stats_csv(long verified_decimals, int matches, int num_positions, double verification_time) {
+    printf("%ld;", verified_decimals);
+    printf("%d;", matches);
+    printf("%f;", verification_time);
+}
+
+void print_hex_check_stats(long correct_digits, long reference_digits, double check_time) {
+    if (correct_digits >= reference_digits) { printf("  Correct hex digits: %ld (the whole hex reference) \n", correct_digits); }
+    else { printf("  Correct hex digits: %ld \n", correct_digits); }
+    printf("  Hex check time (no decimal conversion): %f seconds \n", check_time);
+    printf("\n");
+}
+
+void print_hex_check_stats_csv(long correct_digits, long reference_digits, double check_time) {
+    printf("%ld;", correct_digits);
+    printf("%f;", check_time);
+}
+
+void print_hex_output_stats(char * path, long digits, double output_time) {
+    printf("  Hex digits written to %s: %ld \n", path, digits);
+    printf("  Hex write time (no decimal conversion): %f seconds \n", output_time);
+    printf("\n");
+}
+
+void print_hex_output_stats_csv(char * path, long digits, double output_time) {
+    printf("%ld;", digits);
+    printf("%f;", output_time);
+}
+
+void print_stream_stats(long decimals, long correct_decimals, long terms, double total_time, long * positions, double * latencies, int num_latencies) {
+    int i;
+
+    printf("  Algorithm: GMP-GIB-STR (Gibbons streaming spigot) \n");
+    printf("  Decimals streamed: %ld (%ld terms) \n", decimals, terms);
+    if (correct_decimals >= decimals) { printf("  Correct decimals: %ld \n", correct_decimals); }
+    else if (correct_decimals >= verification_reference_decimals()) { printf("  Correct decimals: %ld (the whole reference, the rest can not be checked) \n", correct_decimals); }
+    else { printf("  Something went wrong. The stream just achieved %ld decimals \n", correct_decimals); }
+    for (i = 0; i < num_latencies; i++) {
+        printf("  Time to the decimal %ld: %f seconds \n", positions[i], latencies[i]);
+    }
+    printf("  Execution time: %f seconds (%.0f decimals per second) \n", total_time, (total_time > 0) ? decimals / total_time : 0.0);
+    printf("\n");
+}
+
+void print_stream_stats_csv(long decimals, long correct_decimals, long terms, double total_time, long * positions, double * latencies, int num_latencies) {
+    int i;
+
+    printf("OMP;GMP;GMP-GIB-STR;");
+    printf("%ld;", decimals);
+    printf("%ld;", terms);
+    printf("%ld;", correct_decimals);
+    printf("%f;", total_time);
+    for (i = 0; i < num_latencies; i++) {
+        printf("%ld;%f;", positions[i], latencies[i]);
+    }
+}
+
+void print_bench_header(int repetitions, int warmup, bool weak_scaling) {
+    printf("  Benchmark: %d repetitions after %d warmup executions (monotonic clock, %s scaling) \n\n", repetitions, warmup, weak_scaling ? "weak" : "strong");
+    printf("  %-22s %10s %7s %11s %11s %11s %11s %8s %10s %10s \n", "Algorithm", "Precision", "Threads", "Min", "Median", "P95", "Stddev", "Speedup", "Efficiency", "Decimals");
+}
+
+void print_bench_row(char * algorithm_tag, long precision, long num_threads, double min, double median, double p95, double stddev,
+                     double speedup, double efficiency, long decimals_computed) {
+    printf("  %-22s %10ld %7ld %11.6f %11.6f %11.6f %11.6f %8.2f %9.1f%% %10ld \n", algorithm_tag, precision, num_threads,
+           min, median, p95, stddev, speedup, efficiency * 100, decimals_computed);
+}
+
+void print_bench_row_csv(char * library, char * algorithm_tag, long precision, long num_threads, int repetitions, double min, double median,
+                         double p95, double mean, double stddev, double speedup, double efficiency, long decimals_computed) {
+    printf("BENCH;");
+    printf("%s;", library);
+    printf("%s;", algorithm_tag);
+    printf("%ld;", precision);
+    printf("%ld;", num_threads);
+    printf("%d;", repetitions);
+    printf("%f;%f;%f;%f;%f;", min, median, p95, mean, stddev);
+    printf("%f;%f;", speedup, efficiency);
+    printf("%ld;\n", decimals_computed);
+}
+
+void print_checkpoint_stats(unsigned long written, unsigned long bytes, double write_time, int resumed) {
+    printf("  Threads resumed from checkpoints: %d \n", resumed);
+    printf("  Checkpoints written: %lu (%.2f MB) \n", written, bytes / 1048576.0);
+    printf("  Time of the checkpoint writer (overlapped with the execution): %f seconds \n", write_time);
+    printf("\n");
+}
+
+void print_checkpoint_stats_csv(unsigned long written, unsigned long bytes, double write_time, int resumed) {
+    printf("%d;", resumed);
+    printf("%lu;", written);
+    printf("%lu;", bytes);
+    printf("%f;", write_time);
+}
+
+void print_phase_timers(double * phase_times, double * cpu_times, int num_threads, double imbalance, double idle_fraction) {
+    int i;
+
+    printf("  Load imbalance (max / mean of seed + series): %.3f \n", imbalance);
+    printf("  Idle fraction (waiting at the reduction): %.2f %% \n", idle_fraction * 100);
+    for (i = 0; i < num_threads; i++) {
+        printf("  Thread %-3d -> seed: %f s, series: %f s, wait: %f s, reduction: %f s, cpu: %f s \n", i,
+               phase_times[i * 4], phase_times[i * 4 + 1], phase_times[i * 4 + 2], phase_times[i * 4 + 3], cpu_times[i]);
+    }
+    printf("\n");
+}
+
+void print_phase_timers_csv(double * phase_times, double * cpu_times, int num_threads, double imbalance, double idle_fraction) {
+    int i, phase;
+
+    printf("%f;", imbalance);
+    printf("%f;", idle_fraction);
+    //Each phase is a single field with the times of the threads: time_0/time_1/...
+    for (phase = 0; phase < 4; phase++) {
+        for (i = 0; i < num_threads; i++) {
+            printf((i + 1 < num_threads) ? "%f/" : "%f;", phase_times[i * 4 + phase]);
+        }
+    }
+    for (i = 0; i < num_threads; i++) {
+        printf((i + 1 < num_threads) ? "%f/" : "%f;", cpu_times[i]);
+    }
+}
+
+/*
+ * One line of counters: cycles, instructions, LLC misses, branch misses and dTLB misses (-1 if not counted)
+ */
+static void print_counters_line(char * label, long * counters) {
+    char *names[] = {"cycles", "instructions", "LLC misses", "branch misses", "dTLB misses"};
+    int counter;
+
+    printf("%s ->", label);
+    for (counter = 0; counter < 5; counter++) {
+        if (counters[counter] < 0) {
+            printf(" %s: n/a", names[counter]);
+        } else {
+            printf(" %s: %ld", names[counter], counters[counter]);
+        }
+        if (counter == 1 && counters[0] > 0 && counters[1] >= 0) {
+            printf(" (IPC %.2f)", (double) counters[1] / counters[0]);
+        }
+        printf((counter < 4) ? "," : " \n");
+    }
+}
+
+void print_perf_counters(long * values, int num_threads, int available, char * reason) {
+    char *phases[] = {"seed", "series", "wait", "reduction"};
+    char label[64];
+    long totals[5];
+    int i, phase, counter;
+
+    if (available == 0) {
+        printf("  Hardware counters: %s \n\n", reason);
+        return;
+    }
+    printf("  Hardware counters (user mode) of each phase: \n");
+    for (phase = 0; phase < 4; phase++) {
+        for (counter = 0; counter < 5; counter++) {
+            totals[counter] = 0;
+            for (i = 0; i < num_threads; i++) {
+                if (values[(i * 4 + phase) * 5 + counter] < 0) totals[counter] = -1;
+                if (totals[counter] >= 0) totals[counter] += values[(i * 4 + phase) * 5 + counter];
+            }
+        }
+        sprintf(label, "  Phase %-9s", phases[phase]);
+        print_counters_line(label, totals);
+        for (i = 0; i < num_threads && num_threads > 1; i++) {
+            sprintf(label, "    Thread %-3d", i);
+            print_counters_line(label, &values[(i * 4 + phase) * 5]);
+        }
+    }
+    printf("\n");
+}
+
+void print_perf_counters_csv(long * values, int num_threads, int available, char * reason) {
+    int i, phase, counter;
+
+    printf("%d;", available);
+    //Each counter of each phase is a single field with the values of the threads: value_0/value_1/...
+    for (phase = 0; phase < 4; phase++) {
+        for (counter = 0; counter < 5; counter++) {
+            for (i = 0; i < num_threads; i++) {
+                printf((i + 1 < num_threads) ? "%ld/" : "%ld;", values[(i * 4 + phase) * 5 + counter]);
+            }
+        }
+    }
+}
@@ -1,9 +1,38 @@
 #ifndef PRINTER
 #define PRINTER
 
+#include <stdbool.h>
+
 void print_title();
-void print_results(char *, char *, int, int, int, int, double);
-void print_results_csv(char *, char *, int, int, int, int, double);
-void check_errors(int, int, int);
+void print_results(char *, char *, long, long, int, long, double);
+void print_results_csv(char *, char *, long, long, int, long, double);
+void check_errors(long, long, int);
+void print_memory_allocator_stats(unsigned long, unsigned long, unsigned long, unsigned long);
+void print_memory_allocator_stats_csv(unsigned long, unsigned long, unsigned long, unsigned long);
+void print_memory_accounting(unsigned long, long, unsigned long *, unsigned long *, unsigned long *, unsigned long *, int, unsigned long, unsigned long);
+void print_memory_accounting_csv(unsigned long, long, unsigned long *, unsigned long *, unsigned long *, unsigned long *, int, unsigned long, unsigned long);
+void print_huge_page_stats(unsigned long, unsigned long, unsigned long);
+void print_huge_page_stats_csv(unsigned long, unsigned long, unsigned long);
+void print_output_stats(char *, long, double, double);
+void print_output_stats_csv(char *, long, double, double);
+void print_packed_stats(char *, long, double, unsigned long);
+void print_packed_stats_csv(char *, long, double, unsigned long);
+void print_hex_verification_stats(long, int, int, double);
+void print_hex_verification_stats_csv(long, int, int, double);
+void print_hex_check_stats(long, long, double);
+void print_hex_check_stats_csv(long, long, double);
+void print_hex_output_stats(char *, long, double);
+void print_hex_output_stats_csv(char *, long, double);
+void print_stream_stats(long, long, long, double, long *, double *, int);
+void print_stream_stats_csv(long, long, long, double, long *, double *, int);
+void print_bench_header(int, int, bool);
+void print_bench_row(char *, long, long, double, double, double, double, double, double, long);
+void print_bench_row_csv(char *, char *, long, long, int, double, double, double, double, double, double, double, long);
+void print_checkpoint_stats(unsigned long, unsigned long, double, int);
+void print_checkpoint_stats_csv(unsigned long, unsigned long, double, int);
+void print_phase_timers(double *, double *, int, double, double);
+void print_phase_timers_csv(double *, double *, int, double, double);
+void print_perf_counters(long *, int, int, char *);
+void print_perf_counters_csv(long *, int, int, char *);
 
 #endif
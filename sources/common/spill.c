@@ -0,0 +1,117 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "spill.h"
+
+
+#define SPILL_MIN_BYTES 1048576         // Smaller values are kept in memory
+#define SPILL_ALIGNMENT 4096            // Slots start at page boundaries (holes can be punched)
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Out-of-core storage: big values that are not needed for a while are spilled to   *
+ * a scratch file                                                                   *
+ *                                                                                  *
+ ************************************************************************************
+ * The scratch file is created in the directory given with -spill (a fast local     *
+ * disk) and unlinked at once, so it disappears with the process. Each spilled      *
+ * value takes a slot of the file:                                                  *
+ *                                                                                  *
+ *      | slot 0 | slot 1 | ...        (offsets taken atomically by the threads)    *
+ *                                                                                  *
+ *      spill_store     pwrite of the value (its memory can be freed)               *
+ *      spill_prefetch  asks the kernel to read the slot in the background          *
+ *      spill_load      pread of the value                                          *
+ *      spill_release   punches a hole in the slot, so the disk space is freed      *
+ *                                                                                  *
+ * The file is read and written through the page cache, so the spilled values only  *
+ * leave the memory when it is needed by the rest of the execution. Only values of  *
+ * 1 MB or more are worth spilling                                                  *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int spill_fd = -1;
+static off_t spill_end = 0;
+
+
+/*
+ * Creates the scratch file in directory
+ */
+void spill_enable(const char * directory){
+    char path[4096];
+
+    snprintf(path, sizeof(path), "%s/PiDecimals.spill.XXXXXX", directory);
+    spill_fd = mkstemp(path);
+    if(spill_fd < 0){
+        printf("  The scratch file can not be created in %s \n\n", directory);
+        exit(-1);
+    }
+    unlink(path);
+}
+
+int spill_is_enabled(){
+    return spill_fd >= 0;
+}
+
+/*
+ * True if a value of bytes bytes should be spilled
+ */
+int spill_worth(size_t bytes){
+    return spill_fd >= 0 && bytes >= SPILL_MIN_BYTES;
+}
+
+static void spill_io_error(const char * operation, size_t bytes){
+    printf("  Spill: the %s of %zu bytes in the scratch file failed \n\n", operation, bytes);
+    exit(-1);
+}
+
+/*
+ * Writes bytes bytes of data in a new slot of the scratch file
+ */
+void spill_store(spill_slot * slot, const void * data, size_t bytes){
+    size_t done = 0;
+    ssize_t written;
+    off_t length = (bytes + SPILL_ALIGNMENT - 1) & ~((off_t) SPILL_ALIGNMENT - 1);
+
+    #pragma omp atomic capture
+    { slot -> offset = spill_end; spill_end += length; }
+    slot -> bytes = bytes;
+
+    while(done < bytes){
+        written = pwrite(spill_fd, (const char *) data + done, bytes - done, slot -> offset + done);
+        if(written <= 0) spill_io_error("write", bytes);
+        done += written;
+    }
+}
+
+/*
+ * The slot will be loaded soon: the kernel starts reading it in the background
+ */
+void spill_prefetch(spill_slot * slot){
+    posix_fadvise(spill_fd, slot -> offset, slot -> bytes, POSIX_FADV_WILLNEED);
+}
+
+/*
+ * Reads the slot in data
+ */
+void spill_load(spill_slot * slot, void * data){
+    size_t done = 0;
+    ssize_t read_bytes;
+
+    while(done < slot -> bytes){
+        read_bytes = pread(spill_fd, (char *) data + done, slot -> bytes - done, slot -> offset + done);
+        if(read_bytes <= 0) spill_io_error("read", slot -> bytes);
+        done += read_bytes;
+    }
+}
+
+/*
+ * Frees the disk space (and the cached pages) of the slot
+ */
+void spill_release(spill_slot * slot){
+    off_t length = (slot -> bytes + SPILL_ALIGNMENT - 1) & ~((off_t) SPILL_ALIGNMENT - 1);
+    fallocate(spill_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, slot -> offset, length);
+}
@@ -0,0 +1,19 @@
+#ifndef SPILL
+#define SPILL
+
+#include <sys/types.h>
+
+typedef struct {
+    off_t offset;
+    size_t bytes;
+} spill_slot;
+
+void spill_enable(const char *);
+int spill_is_enabled();
+int spill_worth(size_t);
+void spill_store(spill_slot *, const void *, size_t);
+void spill_prefetch(spill_slot *);
+void spill_load(spill_slot *, void *);
+void spill_release(spill_slot *);
+
+#endif
@@ -0,0 +1,311 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "packed.h"
+#include "verification.h"
+
+
+#define VERIFICATION_REFERENCE "resources/correct_pi.txt"
+#define VERIFICATION_PACKED_REFERENCE "resources/correct_pi.pack"
+#define VERIFICATION_PROMOTE_CHUNK 16777216     // Decimals compared at once by the promotion
+#define VERIFICATION_PROMOTE_GUARD 64           // Last agreed decimals that are not promoted
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Verification of the decimals against the reference (resources/correct_pi.txt)    *
+ *                                                                                  *
+ ************************************************************************************
+ * The reference is mapped in memory (mmap) once, and the decimals of the result    *
+ * are not printed to a string: the radix conversion (gmp/radix_conversion.c)       *
+ * streams them in chunks, and each chunk is compared with the reference at its     *
+ * offset by the thread that converted it. The first mismatch of a chunk is found   *
+ * with SSE2 (64 bytes per step: 4 compares, joined with and, one movemask), or 8   *
+ * bytes per step without SSE2. The threads keep the lowest mismatch found:         *
+ *                                                                                  *
+ *      correct decimals = offset of the first decimal that does not match          *
+ *                                                                                  *
+ * The text reference has 1M decimals. Longer results are checked against the       *
+ * packed reference (resources/correct_pi.pack, format of common/packed.c), mapped  *
+ * too, when it has more decimals: the reference decimals of each chunk are         *
+ * decoded from its words. It has no size limit and it is extended by promotion     *
+ * (-promote): two packed results of different formulas (BBP, Bellard or            *
+ * Chudnovsky) must match the current reference and the decimals where they agree   *
+ * (but the last 64) become the new reference                                       *
+ *                                                                                  *
+ ************************************************************************************/
+
+static int reference_mapped = 0;
+static const char * reference = NULL;          // Text reference (mapped)
+static long reference_header_bytes = 0;        // Bytes of the integer part and the point
+static packed_file packed_reference;           // Packed reference (mapped)
+static int reference_is_packed = 0;
+static long reference_decimals = 0;
+static unsigned long reference_integer_part = 0;
+static long first_mismatch = 0;
+
+
+/*
+ * Maps the text reference in memory and returns its decimals (-1 if it is not found)
+ */
+static long verification_map_text(){
+    struct stat status;
+    const char * point;
+    long bytes;
+    int fd;
+
+    fd = open(VERIFICATION_REFERENCE, O_RDONLY);
+    if(fd < 0) return -1;
+    if(fstat(fd, &status) != 0 || status.st_size < 2){
+        close(fd);
+        return -1;
+    }
+    reference = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(reference == MAP_FAILED){
+        printf("correct_pi.txt can not be mapped \n");
+        exit(-1);
+    }
+    madvise((void *) reference, status.st_size, MADV_SEQUENTIAL);
+    bytes = status.st_size;
+    while(bytes > 0 && (reference[bytes - 1] == '\n' || reference[bytes - 1] == '\r')) bytes--;
+
+    point = memchr(reference, '.', bytes);
+    reference_header_bytes = (point == NULL) ? bytes : point - reference + 1;
+    reference_integer_part = strtoul(reference, NULL, 10);
+    return bytes - reference_header_bytes;
+}
+
+/*
+ * Maps the reference in memory (only the first time): the packed reference if it
+ * has more decimals than the text one
+ */
+static void verification_map_reference(){
+    long text_decimals;
+
+    if(reference_mapped) return;
+    text_decimals = verification_map_text();
+    reference_decimals = text_decimals;
+    if(access(VERIFICATION_PACKED_REFERENCE, R_OK) == 0){
+        packed_open(&packed_reference, VERIFICATION_PACKED_REFERENCE);
+        if((long) packed_reference.header -> decimals > text_decimals){
+            reference_is_packed = 1;
+            reference_decimals = packed_reference.header -> decimals;
+            reference_integer_part = packed_reference.header -> integer_part;
+        } else {
+            packed_close(&packed_reference);
+        }
+    }
+    if(reference_decimals < 0){
+        printf("correct_pi.txt not found \n");
+        exit(-1);
+    }
+    reference_mapped = 1;
+}
+
+/*
+ * Decimals [offset, offset + length) of the reference (decoded in buffer if the reference is packed)
+ */
+static const char * verification_reference_digits(long offset, long length, char * buffer){
+    if(!reference_is_packed) return reference + reference_header_bytes + offset;
+    packed_read(&packed_reference, offset, offset + length, buffer);
+    return buffer;
+}
+
+/*
+ * Number of decimals of the reference
+ */
+long verification_reference_decimals(){
+    verification_map_reference();
+    return reference_decimals;
+}
+
+/*
+ * Position of the first byte that differs in a and b (length if they are equal)
+ */
+long verification_first_mismatch(const char * a, const char * b, long length){
+    long i = 0;
+
+#if defined(__SSE2__)
+    __m128i equal;
+    unsigned int mask;
+
+    for(; i + 64 <= length; i += 64){
+        equal = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i)), _mm_loadu_si128((const __m128i *) (b + i))),
+                                            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i + 16)), _mm_loadu_si128((const __m128i *) (b + i + 16)))),
+                              _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i + 32)), _mm_loadu_si128((const __m128i *) (b + i + 32))),
+                                            _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i + 48)), _mm_loadu_si128((const __m128i *) (b + i + 48)))));
+        if(_mm_movemask_epi8(equal) != 0xFFFF) break;
+    }
+    for(; i + 16 <= length; i += 16){
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + i)), _mm_loadu_si128((const __m128i *) (b + i))));
+        if(mask != 0xFFFF) return i + __builtin_ctz(~mask);
+    }
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t word_a, word_b;
+
+    for(; i + 8 <= length; i += 8){
+        memcpy(&word_a, a + i, 8);
+        memcpy(&word_b, b + i, 8);
+        if(word_a != word_b) return i + __builtin_ctzll(word_a ^ word_b) / 8;
+    }
+#endif
+
+    for(; i < length; i++){
+        if(a[i] != b[i]) return i;
+    }
+    return length;
+}
+
+/*
+ * Starts the verification of a result with integer_part and decimals decimals
+ */
+void verification_begin(unsigned long integer_part, long decimals){
+    verification_map_reference();
+    first_mismatch = (integer_part == reference_integer_part) ? decimals : 0;
+}
+
+/*
+ * Compares length decimals, starting at the decimal offset, with the reference.
+ * It can be called by several threads at the same time
+ */
+void verification_check_chunk(long offset, char * digits, long length){
+    long mismatch, current;
+    char * buffer = NULL;
+
+    #pragma omp atomic read
+    current = first_mismatch;
+    if(offset >= current) return;
+    if(offset + length > reference_decimals) length = reference_decimals - offset;
+
+    if(reference_is_packed){
+        buffer = malloc(length);
+        if(buffer == NULL){
+            printf("Not enough memory to check the decimals \n");
+            exit(-1);
+        }
+    }
+    mismatch = offset + verification_first_mismatch(digits, verification_reference_digits(offset, length, buffer), length);
+    free(buffer);
+    if(mismatch == offset + length) return;
+    #pragma omp critical(verification)
+    {
+        if(mismatch < first_mismatch) first_mismatch = mismatch;
+    }
+}
+
+/*
+ * Number of correct decimals of the result
+ */
+long verification_end(){
+    return first_mismatch;
+}
+
+/*
+ * Formula of an algorithm tag (GMP-CHD-SME-BLC -> CHD)
+ */
+static void verification_formula(const char * algorithm_tag, char * formula, size_t bytes){
+    const char * start = strchr(algorithm_tag, '-');
+    size_t length;
+
+    start = (start == NULL) ? algorithm_tag : start + 1;
+    length = strcspn(start, "-");
+    if(length >= bytes) length = bytes - 1;
+    memcpy(formula, start, length);
+    formula[length] = '\0';
+}
+
+/*
+ * Promotes the decimals where two packed results computed with different formulas agree
+ * (and agree with the reference) to the packed reference, if they extend it
+ */
+void verification_promote(char * path_a, char * path_b){
+    char formula_a[PACKED_TAG_BYTES], formula_b[PACKED_TAG_BYTES], new_path[4096];
+    char * digits_a, * digits_b, * buffer;
+    packed_file a, b;
+    long decimals, agreed, offset, length, mismatch, checked;
+
+    verification_map_reference();
+    packed_open(&a, path_a);
+    packed_open(&b, path_b);
+    verification_formula(a.header -> algorithm_tag, formula_a, sizeof(formula_a));
+    verification_formula(b.header -> algorithm_tag, formula_b, sizeof(formula_b));
+    if(strcmp(formula_a, formula_b) == 0){
+        printf("  %s and %s were computed with the same formula (%s): the promotion needs two independent methods \n\n", path_a, path_b, formula_a);
+        exit(-1);
+    }
+    if(a.header -> integer_part != reference_integer_part || b.header -> integer_part != reference_integer_part){
+        printf("  The integer part of the results does not match the reference \n\n");
+        exit(-1);
+    }
+
+    digits_a = malloc(VERIFICATION_PROMOTE_CHUNK);
+    digits_b = malloc(VERIFICATION_PROMOTE_CHUNK);
+    buffer = malloc(VERIFICATION_PROMOTE_CHUNK);
+    if(digits_a == NULL || digits_b == NULL || buffer == NULL){
+        printf("Not enough memory to promote the decimals \n");
+        exit(-1);
+    }
+
+    //Decimals where both results agree (the part covered by the reference must match it)
+    decimals = (a.header -> decimals < b.header -> decimals) ? a.header -> decimals : b.header -> decimals;
+    agreed = decimals;
+    for(offset = 0; offset < decimals; offset += VERIFICATION_PROMOTE_CHUNK){
+        length = (decimals - offset < VERIFICATION_PROMOTE_CHUNK) ? decimals - offset : VERIFICATION_PROMOTE_CHUNK;
+        packed_read(&a, offset, offset + length, digits_a);
+        packed_read(&b, offset, offset + length, digits_b);
+        mismatch = verification_first_mismatch(digits_a, digits_b, length);
+        if(offset < reference_decimals){
+            checked = (reference_decimals - offset < length) ? reference_decimals - offset : length;
+            if(mismatch < checked || verification_first_mismatch(digits_a, verification_reference_digits(offset, checked, buffer), checked) < checked){
+                printf("  The results do not match the reference (%ld decimals) \n\n", reference_decimals);
+                exit(-1);
+            }
+        }
+        if(mismatch < length){
+            agreed = offset + mismatch;
+            break;
+        }
+    }
+    agreed -= VERIFICATION_PROMOTE_GUARD;
+    if(agreed <= reference_decimals){
+        printf("  The results agree in %ld decimals: the reference (%ld decimals) is not extended \n\n", agreed, reference_decimals);
+        free(digits_a);
+        free(digits_b);
+        free(buffer);
+        packed_close(&a);
+        packed_close(&b);
+        return;
+    }
+
+    //The new reference is written aside and renamed, so the old one is valid until the end
+    snprintf(new_path, sizeof(new_path), "%s.new", VERIFICATION_PACKED_REFERENCE);
+    packed_enable(new_path);
+    packed_begin("REFERENCE", agreed, reference_integer_part, agreed);
+    for(offset = 0; offset < agreed; offset += VERIFICATION_PROMOTE_CHUNK){
+        length = (agreed - offset < VERIFICATION_PROMOTE_CHUNK) ? agreed - offset : VERIFICATION_PROMOTE_CHUNK;
+        packed_read(&a, offset, offset + length, digits_a);
+        packed_write_digits(offset, digits_a, length);
+    }
+    packed_end(1);
+    if(rename(new_path, VERIFICATION_PACKED_REFERENCE) != 0){
+        printf("  %s can not be replaced \n\n", VERIFICATION_PACKED_REFERENCE);
+        exit(-1);
+    }
+    printf("  Reference extended from %ld to %ld decimals (%s and %s agree) \n\n", reference_decimals, agreed, a.header -> algorithm_tag, b.header -> algorithm_tag);
+
+    free(digits_a);
+    free(digits_b);
+    free(buffer);
+    packed_close(&a);
+    packed_close(&b);
+}
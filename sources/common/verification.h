@@ -0,0 +1,11 @@
+#ifndef VERIFICATION
+#define VERIFICATION
+
+long verification_reference_decimals();
+long verification_first_mismatch(const char *, const char *, long);
+void verification_begin(unsigned long, long);
+void verification_check_chunk(long, char *, long);
+long verification_end();
+void verification_promote(char *, char *);
+
+#endif
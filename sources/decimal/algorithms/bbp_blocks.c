@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "bbp_blocks.h"
+#include "../reduction.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Bailey Borwein Plouffe formula in base 10^18 fixed point (DEC library)           *
+ * It uses a block distribution                                                     *
+ *                                                                                  *
+ ************************************************************************************
+ * Bailey Borwein Plouffe formula:                                                  *
+ *                      1        4          2        1       1                      *
+ *    pi = SUMMATORY( ------ [ ------  - ------ - ------ - ------]),  n >=0         *
+ *                     16^n    8n + 1    8n + 4   8n + 5   8n + 6                   *
+ *                                                                                  *
+ * Each thread keeps the power 1/16^n and adds the 4 quotients of the term in one   *
+ * pass over its limbs (fixed_point.c), dividing it by 16 in the same pass. The     *
+ * first power of a block is 1 / 2^(4 block_start)                                  *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+void dec_bbp_blocks_algorithm(dec_fixed * pi, long num_iterations, int num_threads){
+    dec_fixed * partials[num_threads];
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel 
+    {
+        const long coefficients[4] = {4, -2, -1, -1};
+        unsigned long divisors[4];
+        int thread_id;
+        long i, block_start, block_end;
+        dec_fixed local_pi, power;
+
+        thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
+
+        dec_fixed_init(&local_pi, pi -> num_limbs);         // private thread pi
+        dec_fixed_init(&power, pi -> num_limbs);
+        dec_fixed_set_ui(&power, 1);
+        dec_fixed_div_2exp(&power, 4 * (unsigned long) block_start);     // power = (1/16)^n
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
+        //First Phase -> Working on a local variable        
+        for(i = block_start; i < block_end; i++){
+            divisors[0] = 8 * i + 1;
+            divisors[1] = 8 * i + 4;
+            divisors[2] = 8 * i + 5;
+            divisors[3] = 8 * i + 6;
+            dec_fixed_add_term(&local_pi, &power, coefficients, divisors, 4, 16);
+        }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
+
+        //Second Phase -> Accumulate the result in the global variable
+        dec_tree_reduction(pi, &local_pi, partials, thread_id, num_threads);
+
+        //Clear thread memory
+        dec_fixed_clear(&local_pi);
+        dec_fixed_clear(&power);
+    }
+}
@@ -0,0 +1,8 @@
+#ifndef DEC_BBP_BLOCKS
+#define DEC_BBP_BLOCKS
+
+#include "../fixed_point.h"
+
+void dec_bbp_blocks_algorithm(dec_fixed *, long, int);
+
+#endif
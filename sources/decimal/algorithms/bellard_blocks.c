@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "bellard_blocks.h"
+#include "../reduction.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Bellard formula in base 10^18 fixed point (DEC library)                          *
+ * It uses a block distribution                                                     *
+ *                                                                                  *
+ ************************************************************************************
+ * Bellard formula:                                                                 *
+ *                 (-1)^n     32     1      256     64       4       4       1      *
+ * 2^6 * pi = SUM( ------ [- ---- - ---- + ----- - ----- - ----- - ----- + -----])  *
+ *         n=0     1024^n    4n+1   4n+3   10n+1   10n+3   10n+5   10n+7   10n+9    *
+ *                                                                                  *
+ * Each thread keeps the power 1/(2^6 1024^n) and adds the 7 quotients of the term  *
+ * (with the sign of n) in one pass over its limbs (fixed_point.c), dividing it by  *
+ * 1024 in the same pass. The first power of a block is 1 / 2^(6 + 10 block_start)  *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+void dec_bellard_blocks_algorithm(dec_fixed * pi, long num_iterations, int num_threads){
+    dec_fixed * partials[num_threads];
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel 
+    {
+        const long positive[7] = {-32, -1, 256, -64, -4, -4, 1};
+        const long negative[7] = {32, 1, -256, 64, 4, 4, -1};
+        unsigned long divisors[7];
+        int thread_id;
+        long i, block_start, block_end;
+        dec_fixed local_pi, power;
+
+        thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
+
+        dec_fixed_init(&local_pi, pi -> num_limbs);         // private thread pi
+        dec_fixed_init(&power, pi -> num_limbs);
+        dec_fixed_set_ui(&power, 1);
+        dec_fixed_div_2exp(&power, 6 + 10 * (unsigned long) block_start);    // power = 1 / (2^6 1024^n)
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
+        //First Phase -> Working on a local variable        
+        for(i = block_start; i < block_end; i++){
+            divisors[0] = 4 * i + 1;
+            divisors[1] = 4 * i + 3;
+            divisors[2] = 10 * i + 1;
+            divisors[3] = 10 * i + 3;
+            divisors[4] = 10 * i + 5;
+            divisors[5] = 10 * i + 7;
+            divisors[6] = 10 * i + 9;
+            dec_fixed_add_term(&local_pi, &power, (i % 2 == 0) ? positive : negative, divisors, 7, 1024);
+        }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
+
+        //Second Phase -> Accumulate the result in the global variable
+        dec_tree_reduction(pi, &local_pi, partials, thread_id, num_threads);
+
+        //Clear thread memory
+        dec_fixed_clear(&local_pi);
+        dec_fixed_clear(&power);
+    }
+}
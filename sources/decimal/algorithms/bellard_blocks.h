@@ -0,0 +1,8 @@
+#ifndef DEC_BELLARD_BLOCKS
+#define DEC_BELLARD_BLOCKS
+
+#include "../fixed_point.h"
+
+void dec_bellard_blocks_algorithm(dec_fixed *, long, int);
+
+#endif
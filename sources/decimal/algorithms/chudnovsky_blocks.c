@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <omp.h>
+#include "chudnovsky_blocks.h"
+#include "../reduction.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../../gmp/algorithms/chudnovsky_simplified_expression_integers_blocks.h"
+
+
+#define A 13591409
+#define B 545140134
+#define C 640320
+#define D 426880
+#define E 10005
+#define C3 262537412640768000UL         // 640320^3 (it fits in 64 bits)
+#define PAIR_MAX 300000000L             // (12n + 2)(12n + 6) fits in 64 bits below it
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Chudnovsky formula in base 10^18 fixed point (DEC library)                       *
+ * It uses a block distribution                                                     *
+ *                                                                                  *
+ ************************************************************************************
+ * Chudnovsky formula:                                                              *
+ *     426880 sqrt(10005)                 (6n)! (545140134n + 13591409)             *
+ *    --------------------  = SUMMATORY( ----------------------------- ),  n >=0    *
+ *            pi                            (n!)^3 (3n)! (-640320)^3n               *
+ *                                                                                  *
+ * Each thread keeps the power t(n) = (6n)! / ((n!)^3 (3n)! 640320^3n) and, in one  *
+ * pass over its limbs (fixed_point.c), adds (-1)^n (545140134n + 13591409) t(n)    *
+ * and divides it by 640320^3 (one 64 bits divisor). Then the power is multiplied   *
+ * by the rest of the ratio of two terms, with small divisions too:                 *
+ *                                                                                  *
+ *                    (12n + 2)(12n + 6)    12n + 10    1                           *
+ *      t(n + 1) = -------------------- * -------- * -------- * t(n)                *
+ *                       (n + 1)^2          n + 1    640320^3                       *
+ *                                                                                  *
+ * The first power of a block, t(block_start), is computed once with mpz integers   *
+ * (the exact dep_a of GMP-CHD-SME-INT-BLC divided by 640320^(3 block_start)).      *
+ *                                                                                  *
+ * The division of the end is done once with mpz integers too, over the numbers     *
+ * times X = 10^(18 (num_limbs - 1)) (their limbs as one integer):                  *
+ *                                                                                  *
+ *      pi X = 426880 sqrt(10005 X^2) X / (sum X)                                   *
+ *                                                                                  *
+ * Unlike BBP and Bellard, these steps are radix conversions (dec_fixed_set_z and   *
+ * dec_fixed_get_z): one per block seed and two at the end, inside the time of the  *
+ * execution                                                                        *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * power = t(block_start) = dep_a(block_start) / 640320^(3 block_start)
+ */
+static void dec_chudnovsky_seed(dec_fixed * power, long block_start){
+    mpz_t dep_a, dep_b, scale;
+
+    mpz_inits(dep_a, dep_b, scale, NULL);
+    mpz_compute_dep_a_gmp(dep_a, block_start);
+    mpz_ui_pow_ui(dep_b, C, 3 * block_start);
+    mpz_ui_pow_ui(scale, 10, (power -> num_limbs - 1) * DEC_LIMB_DIGITS);
+    mpz_mul(dep_a, dep_a, scale);
+    mpz_tdiv_q(dep_a, dep_a, dep_b);
+    dec_fixed_set_z(power, dep_a);
+    mpz_clears(dep_a, dep_b, scale, NULL);
+}
+
+/*
+ * pi = 426880 sqrt(10005) / pi, with one square root and one division of integers
+ */
+static void dec_chudnovsky_divide(dec_fixed * pi){
+    mpz_t sum, e, scale;
+
+    mpz_inits(sum, e, scale, NULL);
+    dec_fixed_get_z(sum, pi);
+    mpz_ui_pow_ui(scale, 10, (pi -> num_limbs - 1) * DEC_LIMB_DIGITS);
+    mpz_mul(e, scale, scale);
+    mpz_mul_ui(e, e, E);
+    mpz_sqrt(e, e);
+    mpz_mul_ui(e, e, D);
+    mpz_mul(e, e, scale);
+    mpz_tdiv_q(e, e, sum);
+    dec_fixed_set_z(pi, e);
+    mpz_clears(sum, e, scale, NULL);
+}
+
+
+void dec_chudnovsky_blocks_algorithm(dec_fixed * pi, long num_iterations, int num_threads){
+    dec_fixed * partials[num_threads];
+
+    //Set the number of threads 
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel 
+    {
+        const unsigned long divisors[1] = {1};
+        long coefficients[1];
+        int thread_id;
+        long i, block_start, block_end;
+        dec_fixed local_pi, power;
+
+        thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
+
+        dec_fixed_init(&local_pi, pi -> num_limbs);         // private thread pi
+        dec_fixed_init(&power, pi -> num_limbs);
+        if(block_start == 0){
+            dec_fixed_set_ui(&power, 1);
+        } else if(block_start < block_end){
+            dec_chudnovsky_seed(&power, block_start);
+        }
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
+        //First Phase -> Working on a local variable        
+        for(i = block_start; i < block_end; i++){
+            coefficients[0] = (i % 2 == 0) ? A + B * i : -(A + B * i);
+            dec_fixed_add_term(&local_pi, &power, coefficients, divisors, 1, C3);
+            if(i < PAIR_MAX){
+                dec_fixed_mul_div_ui(&power, (12 * i + 2) * (12 * i + 6), (i + 1) * (i + 1));
+            } else {
+                dec_fixed_mul_div_ui(&power, 12 * i + 2, i + 1);
+                dec_fixed_mul_div_ui(&power, 12 * i + 6, i + 1);
+            }
+            dec_fixed_mul_div_ui(&power, 12 * i + 10, i + 1);
+        }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
+
+        //Second Phase -> Accumulate the result in the global variable
+        dec_tree_reduction(pi, &local_pi, partials, thread_id, num_threads);
+
+        //Clear thread memory
+        dec_fixed_clear(&local_pi);
+        dec_fixed_clear(&power);
+    }
+
+    dec_chudnovsky_divide(pi);
+}
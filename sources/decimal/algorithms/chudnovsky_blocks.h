@@ -0,0 +1,8 @@
+#ifndef DEC_CHUDNOVSKY_BLOCKS
+#define DEC_CHUDNOVSKY_BLOCKS
+
+#include "../fixed_point.h"
+
+void dec_chudnovsky_blocks_algorithm(dec_fixed *, long, int);
+
+#endif
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include <omp.h>
+#include "fixed_point.h"
+
+
+#define DEC_GUARD_LIMBS 2               // Limbs after the last decimal given (the truncation errors stay there)
+#define DEC_CHUNK 1048572               // Decimals streamed at once by each thread (a multiple of 18)
+#define DEC_MAX_QUOTIENTS 8
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Fixed point numbers in base 10^18 (DEC library)                                  *
+ *                                                                                  *
+ ************************************************************************************
+ * A number is an array of 64 bits limbs in base 10^18: the limb 0 is the integer   *
+ * part and the next ones the fraction, the most significant first:                 *
+ *                                                                                  *
+ *      pi = 3 | 141592653589793238 | 462643383279502884 | ...                      *
+ *                                                                                  *
+ * The term-by-term series (BBP and Bellard) only divide by small integers and      *
+ * add, so they are done limb by limb, from the most significant limb down, with    *
+ * 128 bits remainders:                                                             *
+ *                                                                                  *
+ *      q = (r * 10^18 + limb) / d,   r = (r * 10^18 + limb) % d                    *
+ *                                                                                  *
+ * One pass over the power 1/b^n adds every quotient of the term to the sum and     *
+ * divides the power by b for the next term. The leading zeros of the power are     *
+ * skipped, so the terms get cheaper as n grows. The sum keeps signed limbs and     *
+ * the carries are only propagated at the end.                                      *
+ *                                                                                  *
+ * Chudnovsky also multiplies the power by the ratio of two terms, a quotient of    *
+ * 64 bits integers p / q bigger than 1. The same pass divides by q from the most   *
+ * significant limb down and the part of p * quotient over 10^18 goes to the        *
+ * previous limb, so the limbs of the power may be a bit over 10^18 until the next  *
+ * pass. Its seed and its final division are done once with mpz integers (the       *
+ * number times 10^(18 (num_limbs - 1))). dec_fixed_get_z and dec_fixed_set_z are   *
+ * full radix conversions (mpz_set_str and mpz_get_str), so Chudnovsky pays one     *
+ * conversion for the seed of each block and two for the final division.            *
+ *                                                                                  *
+ * The decimals are the limbs printed with 18 digits: the output needs no radix     *
+ * conversion. They are streamed in chunks to the same consumers as the chunks of   *
+ * gmp/radix_conversion.c (check, -o and -packed). BBP and Bellard never leave      *
+ * base 10^18, so their times have no conversion at all                             *
+ *                                                                                  *
+ ************************************************************************************/
+
+
+/*
+ * Limbs of a number with precision decimals
+ */
+long dec_fixed_limbs(long precision){
+    return 1 + (precision + DEC_LIMB_DIGITS - 1) / DEC_LIMB_DIGITS + DEC_GUARD_LIMBS;
+}
+
+void dec_fixed_init(dec_fixed * x, long num_limbs){
+    x -> limbs = calloc(num_limbs, sizeof(int64_t));
+    if(x -> limbs == NULL){
+        printf("Not enough memory for a number of %ld limbs \n", num_limbs);
+        exit(-1);
+    }
+    x -> num_limbs = num_limbs;
+    x -> first = num_limbs;
+}
+
+void dec_fixed_clear(dec_fixed * x){
+    free(x -> limbs);
+    x -> limbs = NULL;
+}
+
+void dec_fixed_set_ui(dec_fixed * x, unsigned long value){
+    memset(x -> limbs, 0, x -> num_limbs * sizeof(int64_t));
+    x -> limbs[0] = value;
+    x -> first = (value == 0) ? x -> num_limbs : 0;
+}
+
+/*
+ * x = x / divisor (x must be normalized)
+ */
+static void dec_fixed_div_ui(dec_fixed * x, unsigned long divisor){
+    unsigned __int128 current;
+    unsigned long remainder = 0;
+    long j;
+
+    for(j = x -> first; j < x -> num_limbs; j++){
+        current = (unsigned __int128) remainder * DEC_BASE + x -> limbs[j];
+        x -> limbs[j] = current / divisor;
+        remainder = current % divisor;
+    }
+    while(x -> first < x -> num_limbs && x -> limbs[x -> first] == 0) x -> first++;
+}
+
+/*
+ * x = x / 2^bits
+ */
+void dec_fixed_div_2exp(dec_fixed * x, unsigned long bits){
+    unsigned long step;
+
+    while(bits > 0){
+        step = (bits < 60) ? bits : 60;
+        dec_fixed_div_ui(x, 1UL << step);
+        bits -= step;
+    }
+}
+
+/*
+ * sum = sum + power * (coefficients[0] / divisors[0] + ... ) and power = power / power_divisor,
+ * in one pass over the limbs of power. A quotient may be bigger than 64 bits (Chudnovsky adds
+ * (13591409 + 545140134n) / 1)
+ */
+void dec_fixed_add_term(dec_fixed * sum, dec_fixed * power, const long * coefficients, const unsigned long * divisors,
+                        int num_quotients, unsigned long power_divisor){
+    unsigned long remainders[DEC_MAX_QUOTIENTS] = {0}, magnitudes[DEC_MAX_QUOTIENTS], power_remainder = 0;
+    unsigned __int128 current, quotient;
+    __int128 limb_sum;
+    unsigned long limb;
+    long j;
+    int i;
+
+    for(i = 0; i < num_quotients; i++){
+        magnitudes[i] = (coefficients[i] < 0) ? -coefficients[i] : coefficients[i];
+    }
+
+    for(j = power -> first; j < power -> num_limbs; j++){
+        limb = power -> limbs[j];
+        limb_sum = sum -> limbs[j];
+        for(i = 0; i < num_quotients; i++){
+            current = (unsigned __int128) remainders[i] * DEC_BASE + (unsigned __int128) magnitudes[i] * limb;
+            quotient = current / divisors[i];
+            remainders[i] = current % divisors[i];
+            limb_sum += (coefficients[i] < 0) ? -(__int128) quotient : (__int128) quotient;
+        }
+        current = (unsigned __int128) power_remainder * DEC_BASE + limb;
+        power -> limbs[j] = current / power_divisor;
+        power_remainder = current % power_divisor;
+
+        //The limb keeps less than 10^18 (with sign) and the rest goes to the previous limb
+        if(j > 0){
+            sum -> limbs[j] = limb_sum % DEC_BASE;
+            sum -> limbs[j - 1] += limb_sum / DEC_BASE;
+        } else {
+            sum -> limbs[j] = limb_sum;
+        }
+    }
+    j = (power -> first > 0) ? power -> first - 1 : 0;
+    if(j < sum -> first) sum -> first = j;
+    while(power -> first < power -> num_limbs && power -> limbs[power -> first] == 0) power -> first++;
+}
+
+/*
+ * x = x * multiplier / divisor (x positive), in one pass over the limbs of x. The limbs
+ * of x may be over 10^18 by less than multiplier / divisor + 1 (not normalized)
+ */
+void dec_fixed_mul_div_ui(dec_fixed * x, unsigned long multiplier, unsigned long divisor){
+    unsigned __int128 current, quotient;
+    unsigned long remainder = 0;
+    long j;
+
+    for(j = x -> first; j < x -> num_limbs; j++){
+        current = (unsigned __int128) remainder * DEC_BASE + (unsigned __int128) multiplier * (unsigned long) x -> limbs[j];
+        quotient = current / divisor;
+        remainder = current % divisor;
+
+        //The limb keeps less than 10^18 and the rest goes to the previous limb
+        if(j > 0){
+            x -> limbs[j] = quotient % DEC_BASE;
+            x -> limbs[j - 1] += quotient / DEC_BASE;
+        } else {
+            x -> limbs[j] = quotient;
+        }
+    }
+    if(x -> first > 0 && x -> limbs[x -> first - 1] != 0) x -> first--;
+    while(x -> first < x -> num_limbs && x -> limbs[x -> first] == 0) x -> first++;
+}
+
+/*
+ * Propagates the carries, so every limb of the fraction is in [0, 10^18)
+ */
+void dec_fixed_normalize(dec_fixed * x){
+    int64_t carry = 0, limb;
+    long j;
+
+    for(j = x -> num_limbs - 1; j > 0; j--){
+        limb = x -> limbs[j] + carry;
+        carry = limb / DEC_BASE;
+        limb -= carry * DEC_BASE;
+        if(limb < 0){
+            limb += DEC_BASE;
+            carry--;
+        }
+        x -> limbs[j] = limb;
+    }
+    x -> limbs[0] += carry;
+    x -> first = 0;
+    while(x -> first < x -> num_limbs && x -> limbs[x -> first] == 0) x -> first++;
+}
+
+/*
+ * a = a + b (both normalized)
+ */
+void dec_fixed_add(dec_fixed * a, dec_fixed * b){
+    long j;
+
+    for(j = b -> first; j < b -> num_limbs; j++){
+        a -> limbs[j] += b -> limbs[j];
+    }
+    dec_fixed_normalize(a);
+}
+
+/*
+ * Decimals of x that are given (the guard limbs are left out)
+ */
+long dec_fixed_decimals(dec_fixed * x){
+    return (x -> num_limbs - 1 - DEC_GUARD_LIMBS) * DEC_LIMB_DIGITS;
+}
+
+/*
+ * z = x * 10^(18 (num_limbs - 1)) (x normalized and positive)
+ */
+void dec_fixed_get_z(mpz_t z, dec_fixed * x){
+    char * text = malloc(x -> num_limbs * DEC_LIMB_DIGITS + 2);
+    long j, length;
+
+    if(text == NULL){
+        printf("Not enough memory to convert a number of %ld limbs \n", x -> num_limbs);
+        exit(-1);
+    }
+    length = sprintf(text, "%ld", (long) x -> limbs[0]);
+    for(j = 1; j < x -> num_limbs; j++){
+        length += sprintf(text + length, "%018ld", (long) x -> limbs[j]);
+    }
+    mpz_set_str(z, text, 10);
+    free(text);
+}
+
+/*
+ * x = z / 10^(18 (num_limbs - 1)) (z positive and truncated to the limbs of x)
+ */
+void dec_fixed_set_z(dec_fixed * x, mpz_t z){
+    char * text = malloc(mpz_sizeinbase(z, 10) + 2);
+    long j, start, end;
+    int64_t limb;
+
+    if(text == NULL){
+        printf("Not enough memory to convert a number of %ld limbs \n", x -> num_limbs);
+        exit(-1);
+    }
+    mpz_get_str(text, 10, z);
+
+    //Groups of 18 digits from the last one: the last limb first
+    memset(x -> limbs, 0, x -> num_limbs * sizeof(int64_t));
+    end = strlen(text);
+    for(j = x -> num_limbs - 1; j >= 0 && end > 0; j--){
+        start = (j == 0 || end < DEC_LIMB_DIGITS) ? 0 : end - DEC_LIMB_DIGITS;
+        for(limb = 0; start < end; start++){
+            limb = limb * 10 + (text[start] - '0');
+        }
+        x -> limbs[j] = limb;
+        end -= DEC_LIMB_DIGITS;
+    }
+    x -> first = 0;
+    while(x -> first < x -> num_limbs && x -> limbs[x -> first] == 0) x -> first++;
+    free(text);
+}
+
+/*
+ * Passes the first decimals decimals of the fraction of x (normalized) to consume, in chunks
+ * printed by num_threads threads. consume receives the offset of the chunk (0 is the first
+ * decimal), its digits and its length, and it is called by several threads at the same time
+ */
+void dec_fixed_stream(dec_fixed * x, long decimals, int num_threads, void (*consume)(long, char *, long)){
+    long chunk, num_chunks = (decimals + DEC_CHUNK - 1) / DEC_CHUNK;
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+    for(chunk = 0; chunk < num_chunks; chunk++){
+        long offset = chunk * DEC_CHUNK, length = (offset + DEC_CHUNK < decimals) ? DEC_CHUNK : decimals - offset;
+        long j, done;
+        int64_t limb;
+        char * text = malloc(length + DEC_LIMB_DIGITS);
+        int i;
+
+        if(text == NULL){
+            printf("Not enough memory to print the decimals \n");
+            exit(-1);
+        }
+        //The limb 1 holds the decimals [0, 18)
+        for(j = 1 + offset / DEC_LIMB_DIGITS, done = 0; done < length; j++, done += DEC_LIMB_DIGITS){
+            limb = x -> limbs[j];
+            for(i = DEC_LIMB_DIGITS - 1; i >= 0; i--){
+                text[done + i] = '0' + limb % 10;
+                limb /= 10;
+            }
+        }
+        consume(offset, text, length);
+        free(text);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef DEC_FIXED_POINT
+#define DEC_FIXED_POINT
+
+#include <stdint.h>
+#include <gmp.h>
+
+#define DEC_BASE 1000000000000000000L   // 10^18
+#define DEC_LIMB_DIGITS 18
+
+typedef struct {
+    int64_t * limbs;                    // limbs[0] is the integer part, then the fraction (the most significant first)
+    long num_limbs;
+    long first;                         // Limbs before first are zero (the leading zeros of a power are skipped)
+} dec_fixed;
+
+long dec_fixed_limbs(long);
+void dec_fixed_init(dec_fixed *, long);
+void dec_fixed_clear(dec_fixed *);
+void dec_fixed_set_ui(dec_fixed *, unsigned long);
+void dec_fixed_div_2exp(dec_fixed *, unsigned long);
+void dec_fixed_add_term(dec_fixed *, dec_fixed *, const long *, const unsigned long *, int, unsigned long);
+void dec_fixed_mul_div_ui(dec_fixed *, unsigned long, unsigned long);
+void dec_fixed_add(dec_fixed *, dec_fixed *);
+void dec_fixed_normalize(dec_fixed *);
+long dec_fixed_decimals(dec_fixed *);
+void dec_fixed_get_z(mpz_t, dec_fixed *);
+void dec_fixed_set_z(dec_fixed *, mpz_t);
+void dec_fixed_stream(dec_fixed *, long, int, void (*)(long, char *, long));
+
+#endif
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdbool.h>
+#include "../common/printer.h"
+#include "../common/memory_planner.h"
+#include "../common/iterations.h"
+#include "../common/output.h"
+#include "../common/packed.h"
+#include "../common/verification.h"
+#include "../common/hex_verification.h"
+#include "../common/hex_output.h"
+#include "../common/checkpoint.h"
+#include "../common/bench.h"
+#include "../common/phase_timers.h"
+#include "fixed_point.h"
+#include "algorithms/bbp_blocks.h"
+#include "algorithms/bellard_blocks.h"
+#include "algorithms/chudnovsky_blocks.h"
+
+
+double gettimeofday();
+
+
+
+/*
+ * Returns the number of correct decimals of pi. The limbs are printed in chunks
+ * and compared with the mapped reference (common/verification.c)
+ */
+long dec_check_decimals(dec_fixed * pi, int num_threads){
+    long decimals = dec_fixed_decimals(pi);
+
+    if(decimals > verification_reference_decimals()) decimals = verification_reference_decimals();
+
+    verification_begin(pi -> limbs[0], decimals);
+    dec_fixed_stream(pi, decimals, num_threads, verification_check_chunk);
+    return verification_end();
+}
+
+/*
+ * Writes the first decimals of pi in the output file (-o), printing its limbs
+ */
+void dec_write_pi(dec_fixed * pi, long decimals, int num_threads, bool print_in_csv_format){
+    double output_time;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    output_write_header(pi -> limbs[0]);
+    dec_fixed_stream(pi, decimals, num_threads, output_write_digits);
+    output_close(decimals);
+    gettimeofday(&t2, NULL);
+
+    output_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_output_stats_csv(output_get_path(), decimals, output_time, output_get_write_time());
+    } else {
+        print_output_stats(output_get_path(), decimals, output_time, output_get_write_time());
+    }
+}
+
+/*
+ * Packs the first decimals of pi in the packed file (-packed), printing its limbs
+ */
+void dec_pack_pi(dec_fixed * pi, char * algorithm_tag, long decimals, int num_threads, bool print_in_csv_format){
+    double packed_time;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    packed_begin(algorithm_tag, decimals, pi -> limbs[0], decimals);
+    dec_fixed_stream(pi, decimals, num_threads, packed_write_digits);
+    packed_end(num_threads);
+    gettimeofday(&t2, NULL);
+
+    packed_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_packed_stats_csv(packed_get_path(), decimals, packed_time, packed_get_bytes());
+    } else {
+        print_packed_stats(packed_get_path(), decimals, packed_time, packed_get_bytes());
+    }
+}
+
+void dec_calculate_pi(int algorithm, long precision, int num_threads, bool print_in_csv_format){
+    long num_iterations, decimals_computed, num_limbs;
+    double execution_start, execution_time;
+    char *algorithm_tag;
+    dec_fixed pi;
+
+    //The result is decimal: the binary paths do not apply
+    if (hex_output_is_enabled() || hex_check_is_enabled() || hex_verification_is_enabled()) {
+        printf("  The DEC library computes pi in decimal: -hex, -hex-check and -verify-hex need GMP or MPFR. \n\n");
+        exit(-1);
+    }
+    if (checkpoint_is_enabled()) {
+        printf("  Checkpoints are only written by the block engines of GMP and MPFR. \n\n");
+        exit(-1);
+    }
+
+    phase_timers_begin();
+    execution_start = bench_clock();
+
+    //Set the limbs of base 10^18 (precision decimals and the guard limbs) and init pi
+    num_limbs = dec_fixed_limbs(precision);
+    dec_fixed_init(&pi, num_limbs);
+
+    switch (algorithm)
+    {
+    case 0:
+        num_iterations = iterations_bbp(precision);
+        check_errors(precision, num_iterations, num_threads);
+        algorithm_tag = "DEC-BBP-BLC";
+        memory_planner_check(algorithm_tag, (2 * num_threads + 1) * num_limbs * sizeof(int64_t));
+        dec_bbp_blocks_algorithm(&pi, num_iterations, num_threads);
+        break;
+
+    case 1:
+        num_iterations = iterations_bellard(precision);
+        check_errors(precision, num_iterations, num_threads);
+        algorithm_tag = "DEC-BEL-BLC";
+        memory_planner_check(algorithm_tag, (2 * num_threads + 1) * num_limbs * sizeof(int64_t));
+        dec_bellard_blocks_algorithm(&pi, num_iterations, num_threads);
+        break;
+
+    case 2:
+        num_iterations = iterations_chudnovsky(precision);
+        check_errors(precision, num_iterations, num_threads);
+        algorithm_tag = "DEC-CHD-BLC";
+        //The final division works with mpz integers of twice the limbs and their decimal text
+        memory_planner_check(algorithm_tag, (2 * num_threads + 12) * num_limbs * sizeof(int64_t));
+        dec_chudnovsky_blocks_algorithm(&pi, num_iterations, num_threads);
+        break;
+
+    default:
+        printf("  Algorithm number selected not availabe, try with another number. \n");
+        printf("\n");
+        exit(-1);
+        break;
+    }
+
+    execution_time = bench_clock() - execution_start;
+    decimals_computed = dec_check_decimals(&pi, num_threads);
+    if (bench_is_running()) {
+        bench_record(algorithm_tag, execution_time, decimals_computed);
+    } else if (print_in_csv_format) {
+        print_results_csv("DEC", algorithm_tag, precision, num_iterations, num_threads, decimals_computed, execution_time);
+    } else {
+        print_results("DEC", algorithm_tag, precision, num_iterations, num_threads, decimals_computed, execution_time);
+    }
+    if (output_is_enabled()) {
+        dec_write_pi(&pi, precision, num_threads, print_in_csv_format);
+    }
+    if (packed_is_enabled()) {
+        dec_pack_pi(&pi, algorithm_tag, precision, num_threads, print_in_csv_format);
+    }
+
+    dec_fixed_clear(&pi);
+}
@@ -0,0 +1,6 @@
+#ifndef DEC_PI_CALCULATOR
+#define DEC_PI_CALCULATOR
+
+void dec_calculate_pi(int, long, int, bool);
+
+#endif
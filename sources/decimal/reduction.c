@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "reduction.h"
+#include "../common/phase_timers.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Pairwise (tree) reduction of the partial results of the DEC engines              *
+ *                                                                                  *
+ ************************************************************************************
+ * The same tree as gmp/reduction.c: at each level thread t adds partials[t +       *
+ * stride] into partials[t] when t % (2 * stride) == 0, so the result does not      *
+ * depend on the order in which the threads finish. The partials are normalized     *
+ * before they are added                                                            *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * This method must be called by all the threads of the parallel region
+ * (it contains barriers). partials must be a shared vector with, at least,
+ * num_threads positions. When it returns, pi = pi + sum(local_pi) 
+ */
+void dec_tree_reduction(dec_fixed * pi, dec_fixed * local_pi, dec_fixed ** partials, int thread_id, int num_threads){
+    int stride;
+
+    dec_fixed_normalize(local_pi);
+    partials[thread_id] = local_pi;
+    for(stride = 1; stride < num_threads; stride <<= 1){
+        phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+        #pragma omp barrier
+        phase_timers_lap(thread_id, TIMERS_PHASE_WAIT);
+        if((thread_id % (stride << 1) == 0) && (thread_id + stride < num_threads)){
+            dec_fixed_add(partials[thread_id], partials[thread_id + stride]);
+        }
+    }
+
+    //Wait until all the partials have been read before the threads clear them
+    phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+    #pragma omp barrier
+    phase_timers_lap(thread_id, TIMERS_PHASE_WAIT);
+    if(thread_id == 0){
+        dec_fixed_add(pi, partials[0]);
+    }
+    phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+}
@@ -0,0 +1,8 @@
+#ifndef DEC_REDUCTION
+#define DEC_REDUCTION
+
+#include "fixed_point.h"
+
+void dec_tree_reduction(dec_fixed *, dec_fixed *, dec_fixed **, int, int);
+
+#endif
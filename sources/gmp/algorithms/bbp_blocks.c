@@ -3,6 +3,12 @@
 #include <gmp.h>
 #include <omp.h>
 #include "bbp_cyclic.h"
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../checkpoint.h"
 
 
 #define QUOTIENT 0.0625
@@ -38,43 +44,56 @@
  ************************************************************************************/
 
 
-void gmp_bbp_blocks_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_bbp_blocks_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t quotient; 
 
     mpf_init_set_d(quotient, QUOTIENT);         // quotient = (1 / 16)   
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, block_size, block_start, block_end;
+        int thread_id;
+        long i, block_start, block_end;
         mpf_t local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
 
         mpf_init_set_ui(local_pi, 0);               // private thread pi
         mpf_init(dep_m);
-        mpf_pow_ui(dep_m, quotient, block_start);    // m = (1/16)^n                  
         mpf_inits(quot_a, quot_b, quot_c, quot_d, aux, NULL);
+        mpf_ptr state[] = {local_pi, dep_m};
+
+        //With -resume the thread goes on from its checkpoint
+        if(!gmp_checkpoint_load(thread_id, &block_start, state, 2, NULL, 0)){
+            mpf_pow_ui(dep_m, quotient, block_start);    // m = (1/16)^n                  
+        }
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
 
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             gmp_bbp_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
             // Update dependencies:  
             mpf_mul(dep_m, dep_m, quotient);
+
+            //Checkpoint of the state before the iteration i + 1 (written by another thread)
+            if(checkpoint_due(thread_id)) gmp_checkpoint_save(thread_id, i + 1, state, 2, NULL, 0);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpf_clears(local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);   
+        memory_allocator_release_thread();
     }
         
     //Clear memory
@@ -1,7 +1,7 @@
 #ifndef GMP_BBP_BLOCKS
 #define GMP_BBP_BLOCKS
 
-void gmp_bbp_blocks_algorithm(mpf_t, int, int);
+void gmp_bbp_blocks_algorithm(mpf_t, long, int);
 
 #endif
 
@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
 
 #define QUOTIENT 0.0625
 
@@ -38,14 +42,14 @@
 /*
  * An iteration of Bailey Borwein Plouffe formula
  */
-void gmp_bbp_iteration(mpf_t pi, int n, mpf_t dep_m, mpf_t quot_a, mpf_t quot_b, mpf_t quot_c, mpf_t quot_d, mpf_t aux){
+void gmp_bbp_iteration(mpf_t pi, long n, mpf_t dep_m, mpf_t quot_a, mpf_t quot_b, mpf_t quot_c, mpf_t quot_d, mpf_t aux){
     mpf_set_ui(quot_a, 4);              // quot_a = ( 4 / (8n + 1))
     mpf_set_ui(quot_b, 2);              // quot_b = (-2 / (8n + 4))
     mpf_set_ui(quot_c, 1);              // quot_c = (-1 / (8n + 5))
     mpf_set_ui(quot_d, 1);              // quot_d = (-1 / (8n + 6))
     mpf_set_ui(aux, 0);                 // aux = a + b + c + d  
 
-    int i = n << 3;                     // i = 8n
+    unsigned long i = n << 3;           // i = 8n
     mpf_div_ui(quot_a, quot_a, i | 1);  // 4 / (8n + 1)
     mpf_div_ui(quot_b, quot_b, i | 4);  // 2 / (8n + 4)
     mpf_div_ui(quot_c, quot_c, i | 5);  // 1 / (8n + 5)
@@ -63,40 +67,48 @@ void gmp_bbp_iteration(mpf_t pi, int n, mpf_t dep_m, mpf_t quot_a, mpf_t quot_b,
 }
 
 
-void gmp_bbp_cyclic_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_bbp_cyclic_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t jump, quotient; 
 
     mpf_init_set_d(quotient, QUOTIENT);         // quotient = (1 / 16)   
     mpf_init_set_ui(jump, 1);        
     mpf_pow_ui(jump, quotient, num_threads);    // jump = (1/16)^num_threads
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i;
+        int thread_id;
+        long i;
         mpf_t local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux;
 
         thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
         mpf_init_set_ui(local_pi, 0);               // private thread pi
         mpf_init(dep_m);
         mpf_pow_ui(dep_m, quotient, thread_id);    // m = (1/16)^n                  
         mpf_inits(quot_a, quot_b, quot_c, quot_d, aux, NULL);
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = thread_id; i < num_iterations; i+=num_threads){
             gmp_bbp_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
             // Update dependencies:  
             mpf_mul(dep_m, dep_m, jump);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpf_clears(local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);   
+        memory_allocator_release_thread();
     }
         
     //Clear memory
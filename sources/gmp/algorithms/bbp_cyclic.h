@@ -1,7 +1,7 @@
 #ifndef GMP_BBP_CYCLIC
 #define GMP_BBP_CYCLIC
 
-void gmp_bbp_cyclic_algorithm(mpf_t, int, int);
-void gmp_bbp_iteration(mpf_t, int, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t);
+void gmp_bbp_cyclic_algorithm(mpf_t, long, int);
+void gmp_bbp_iteration(mpf_t, long, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <gmp.h>
 #include <omp.h>
 #include "bellard_recursive_power_cyclic.h"
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
 
 
 /************************************************************************************
@@ -38,19 +42,24 @@
  ************************************************************************************/
 
 
-void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t ONE;
     mpf_init_set_ui(ONE, 1);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b, next_i;
+        int thread_id;
+        long i, dep_a, dep_b, jump_dep_a, jump_dep_b, next_i;
         mpf_t local_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
         mpf_init_set_ui(local_pi, 0);       // private thread pi
         dep_a = thread_id * 4;
         dep_b = thread_id * 10;
@@ -62,6 +71,8 @@ void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t pi, int num_iterations,
         if(thread_id % 2 != 0) mpf_neg(dep_m, dep_m);                   
         mpf_inits(a, b, c, d, e, f, g, aux, NULL);
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable
         for(i = thread_id; i < num_iterations; i+=num_threads){
             gmp_bellard_iteration(local_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
@@ -73,13 +84,14 @@ void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t pi, int num_iterations,
             dep_a += jump_dep_a;
             dep_b += jump_dep_b;  
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpf_clears(local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
     mpf_div_2exp(pi, pi, 6); // pi = pi / 2⁶
@@ -1,7 +1,7 @@
 #ifndef GMP_BELLARD_BIT_SHIFT_POWER_CYCLIC
 #define GMP_BELLARD_BIT_SHIFT_POWER_CYCLIC
 
-void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t, int, int);
+void gmp_bellard_bit_shift_power_cyclic_algorithm(mpf_t, long, int);
 
 #endif
 
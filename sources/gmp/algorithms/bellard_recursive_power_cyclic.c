@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
 
 
 
@@ -41,8 +45,8 @@
 /*
  * An iteration of Bellard formula
  */
-void gmp_bellard_iteration(mpf_t pi, int n, mpf_t m, mpf_t a, mpf_t b, mpf_t c, mpf_t d, 
-                    mpf_t e, mpf_t f, mpf_t g, mpf_t aux, int dep_a, int dep_b){
+void gmp_bellard_iteration(mpf_t pi, long n, mpf_t m, mpf_t a, mpf_t b, mpf_t c, mpf_t d, 
+                    mpf_t e, mpf_t f, mpf_t g, mpf_t aux, long dep_a, long dep_b){
     mpf_set_ui(a, 32);              // a = ( 32 / ( 4n + 1))
     mpf_set_ui(b, 1);               // b = (  1 / ( 4n + 3))
     mpf_set_ui(c, 256);             // c = (256 / (10n + 1))
@@ -77,22 +81,27 @@ void gmp_bellard_iteration(mpf_t pi, int n, mpf_t m, mpf_t a, mpf_t b, mpf_t c,
 }
 
 
-void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t jump; 
 
     mpf_init_set_ui(jump, 1); 
     mpf_div_ui(jump, jump, 1024);
     mpf_pow_ui(jump, jump, num_threads);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b;
+        int thread_id;
+        long i, dep_a, dep_b, jump_dep_a, jump_dep_b;
         mpf_t local_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
         mpf_init_set_ui(local_pi, 0);       // private thread pi
         dep_a = thread_id * 4;
         dep_b = thread_id * 10;
@@ -104,6 +113,8 @@ void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t pi, int num_iterations,
         if(thread_id % 2 != 0) mpf_neg(dep_m, dep_m);                   
         mpf_inits(a, b, c, d, e, f, g, aux, NULL);
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable
         if(num_threads % 2 != 0){
             for(i = thread_id; i < num_iterations; i+=num_threads){
@@ -123,13 +134,14 @@ void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t pi, int num_iterations,
                 dep_b += jump_dep_b;  
             }
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpf_clears(local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
     mpf_div_ui(pi, pi, 64);
@@ -1,8 +1,8 @@
 #ifndef GMP_BELLARD_RECURSIVE_POWER_CYCLIC
 #define GMP_BELLARD_RECURSIVE_POWER_CYCLIC
 
-void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t, int, int);
-void gmp_bellard_iteration(mpf_t, int, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, int, int);
+void gmp_bellard_recursive_power_cyclic_algorithm(mpf_t, long, int);
+void gmp_bellard_iteration(mpf_t, long, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, mpf_t, long, long);
 
 #endif
 
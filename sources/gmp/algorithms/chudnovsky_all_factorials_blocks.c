@@ -1,7 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <gmp.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
+#include "../spill.h"
 
 
 #define A 13591409
@@ -9,6 +18,8 @@
 #define C 640320
 #define D 426880
 #define E 10005
+#define FACTORIAL_CHECKPOINTS_PER_THREAD 4  // Checkpoints of the factorials stored for each thread (at most)
+#define FACTORIAL_LEAF_TERMS 16             // Factors multiplied sequentially in the leaves of the product tree
 
 /************************************************************************************
  * Miguel Pardo Navarro. 17/07/2021                                                 *
@@ -35,40 +46,158 @@
  *              dep_d(n) = (-640320)^(3n) = (-640320)^(3 (n-1)) * (-640320)^3       *
  *              dep_e(n) = (545140134n + 13591409) = dep_c(n - 1) + 545140134       *
  *                                                                                  *
+ ************************************************************************************
+ * The factorials are not stored one by one: only the exact factorials of some      *
+ * checkpoints (every interval terms) are kept as integers:                         *
+ *                                                                                  *
+ *      checkpoints[j] = (j interval)!          j = 0 ... num_checkpoints           *
+ *                                                                                  *
+ * The threads compute them together (product trees of the segments and a parallel  *
+ * scan). Each thread expands the factorials of the start of its block from the     *
+ * nearest checkpoints (then they are freed) and updates them term by term. There   *
+ * are 4 checkpoints per thread, or less if the memory planner does not find room   *
+ * for them                                                                         *
+ *                                                                                  *
  ************************************************************************************/
 
 /*
- * This method calculates the factorials from 0 to num_factorials (included) 
- * and stores them in their corresponding vector position (factorials[n] = n!): 
- * factorials[0] = 1, factorials[1] = 1, factorials[2] = 2, factorials[3] = 6, etc.
- * The computation is performed with a single thread. 
+ * Computes product = (from + 1) (from + 2) ... to with a product tree. In the
+ * out-of-core mode the left half is spilled while the right half is computed, and
+ * it is prefetched during the last product of the right half (next is the spilled
+ * value that the caller will need after this call, or NULL)
+ */
+void gmp_factorial_segment(mpz_t product, unsigned long from, unsigned long to, gmp_spilled_value * next){
+    unsigned long i, half;
+    gmp_spilled_value left;
+    mpz_t right;
+
+    if(to - from <= FACTORIAL_LEAF_TERMS){
+        if(next != NULL) gmp_prefetch_spilled(next);
+        mpz_set_ui(product, 1);
+        for(i = from + 1; i <= to; i++){
+            mpz_mul_ui(product, product, i);
+        }
+        return;
+    }
+
+    half = from + (to - from) / 2;
+    mpz_init(right);
+    gmp_factorial_segment(product, from, half, NULL);
+    gmp_spill_mpz(&left, product);
+    gmp_factorial_segment(right, half, to, &left);
+    if(left.spilled) gmp_reload_mpz(product, &left);
+    if(next != NULL) gmp_prefetch_spilled(next);
+    mpz_mul(product, product, right);
+    mpz_clear(right);
+}
+
+/*
+ * This method computes the checkpoints of the factorials (checkpoints[j] = (j interval)!)
+ * for j = 0 ... num_checkpoints. It must be called by all the threads of the parallel region:
+ *      1. Each checkpoint j > 0 is set to the product of its segment ((j - 1) interval, j interval]
+ *      2. An inclusive scan (Brent-Kung) turns the segments into factorials. The threads
+ *         multiply different checkpoints in each level of the scan
  */
-void gmp_get_factorials(mpf_t * factorials, int num_factorials){
-    int i;
-    mpf_t f;
-    mpf_init_set_ui(f, 1);
-    mpf_init_set_ui(factorials[0], 1);
-    for(i = 1; i <= num_factorials; i++){
-        mpf_mul_ui(f, f, i);
-        mpf_init_set(factorials[i], f);
+void gmp_init_factorial_checkpoints(mpz_t * checkpoints, int num_checkpoints, unsigned long interval){
+    int j, distance, top;
+    mpz_t * segments = checkpoints + 1;
+
+    //The checkpoints are read by all the threads, so they are interleaved among the nodes
+    numa_interleave_begin();
+
+    #pragma omp for schedule(dynamic)
+    for(j = 0; j <= num_checkpoints; j++){
+        mpz_init(checkpoints[j]);
+        if(j == 0) mpz_set_ui(checkpoints[j], 1);
+        else gmp_factorial_segment(checkpoints[j], (j - 1) * interval, j * interval, NULL);
+    }
+
+    //Up-sweep: segments[i] = PRODUCT(segments[i - 2 distance + 1] ... segments[i])
+    for(distance = 1; distance < num_checkpoints; distance *= 2){
+        #pragma omp for schedule(dynamic)
+        for(j = 2 * distance - 1; j < num_checkpoints; j += 2 * distance){
+            mpz_mul(segments[j], segments[j], segments[j - distance]);
+        }
+    }
+    top = distance;
+
+    //Down-sweep: the remaining checkpoints take the products of the previous levels
+    for(distance = top / 2; distance >= 1; distance /= 2){
+        #pragma omp for schedule(dynamic)
+        for(j = 3 * distance - 1; j < num_checkpoints; j += 2 * distance){
+            mpz_mul(segments[j], segments[j], segments[j - distance]);
+        }
     }
-    mpf_clear(f);
+
+    numa_interleave_end();
 }
 
 /*
- * This method clears the factorials computed and stored in mpf_t * factorials
+ * This method clears the checkpoints. It must be called by all the threads of the parallel region
  */
-void gmp_clear_factorials(mpf_t * factorials, int num_factorials){
-    int i;
-    for(i = 0; i <= num_factorials; i++){
-        mpf_clear(factorials[i]);
+void gmp_clear_factorial_checkpoints(mpz_t * checkpoints, int num_checkpoints){
+    int j;
+
+    //No thread may be still reading them
+    #pragma omp barrier
+    #pragma omp for
+    for(j = 0; j <= num_checkpoints; j++){
+        mpz_clear(checkpoints[j]);
     }
 }
 
+/*
+ * Expands n! from the nearest checkpoint below n:
+ *      n! = checkpoints[j] (j interval + 1) ... n
+ */
+void gmp_get_factorial(mpf_t factorial, unsigned long n, mpz_t * checkpoints, int num_checkpoints, unsigned long interval){
+    long j = (n / interval < num_checkpoints) ? n / interval : num_checkpoints;
+    mpz_t segment;
+    mpf_t float_segment;
+
+    mpf_set_z(factorial, checkpoints[j]);
+    if((unsigned long) j * interval == n) return;
+
+    mpz_init(segment);
+    mpf_init(float_segment);
+    gmp_factorial_segment(segment, (unsigned long) j * interval, n, NULL);
+    mpf_set_z(float_segment, segment);
+    mpf_mul(factorial, factorial, float_segment);
+    mpz_clear(segment);
+    mpf_clear(float_segment);
+}
+
+/*
+ * Bytes of the checkpoints: log2((j interval)!) / 8 for each checkpoint
+ */
+unsigned long gmp_chudnovsky_factorial_checkpoints_bytes(long num_iterations, int num_checkpoints){
+    unsigned long interval = (6UL * num_iterations + num_checkpoints - 1) / num_checkpoints;
+    double bytes = 0;
+    int j;
+
+    for(j = 1; j <= num_checkpoints; j++){
+        bytes += lgamma((double) j * interval + 1) / log(2) / 8;
+    }
+    return (unsigned long) bytes;
+}
+
+/*
+ * Number of checkpoints of the factorials. The checkpoints are halved
+ * (down to one) while they do not fit in budget bytes (0: no limit)
+ */
+int gmp_chudnovsky_factorial_checkpoints(long num_iterations, int num_threads, unsigned long budget){
+    int num_checkpoints = FACTORIAL_CHECKPOINTS_PER_THREAD * num_threads;
+
+    while(budget != 0 && num_checkpoints > 1 && gmp_chudnovsky_factorial_checkpoints_bytes(num_iterations, num_checkpoints) > budget){
+        num_checkpoints /= 2;
+    }
+    return num_checkpoints;
+}
+
 /*
  * An iteration of Chudnovsky formula
  */
-void gmp_chudnovsky_all_factorials_iteration(mpf_t pi, int n, mpf_t dep_a, mpf_t dep_b, mpf_t dep_c, 
+void gmp_chudnovsky_all_factorials_iteration(mpf_t pi, long n, mpf_t dep_a, mpf_t dep_b, mpf_t dep_c, 
                         mpf_t dep_d, mpf_t dep_e, mpf_t dividend, mpf_t divisor){
     mpf_mul(dividend, dep_a, dep_e);
 
@@ -80,39 +209,52 @@ void gmp_chudnovsky_all_factorials_iteration(mpf_t pi, int n, mpf_t dep_a, mpf_t
     mpf_add(pi, pi, dividend);
 }
 
-void gmp_chudnovsky_all_factorials_blocks_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_chudnovsky_all_factorials_blocks_algorithm(mpf_t pi, long num_iterations, int num_threads, int num_checkpoints){
     mpf_t e, c;
-    int num_factorials, block_size;
-    
-    num_factorials = num_iterations * 6;
-    mpf_t factorials[num_factorials + 1];
-    gmp_get_factorials(factorials, num_factorials);
+    unsigned long num_factorials, interval;
+
+    num_factorials = 6UL * num_iterations;
+    interval = (num_factorials + num_checkpoints - 1) / num_checkpoints;
+    mpz_t checkpoints[num_checkpoints + 1];
 
-    block_size = (num_iterations + num_threads - 1) / num_threads;
-    mpf_init_set_ui(e, E);
+    mpf_init(e);
     mpf_init_set_ui(c, C);
     mpf_neg(c, c);
     mpf_pow_ui(c, c, 3);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_start, block_end;
-        mpf_t local_pi, dep_a, dep_b, dep_c, dep_d, dep_e, dividend, divisor;
+        int thread_id;
+        long i, block_start, block_end;
+        mpf_t local_pi, dep_a, dep_b, dep_c, dep_d, dep_e, dep_f, dividend, divisor;
 
         thread_id = omp_get_thread_num();
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
+        gmp_init_factorial_checkpoints(checkpoints, num_checkpoints, interval);
+
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
 
         mpf_init_set_ui(local_pi, 0);    // private thread pi
-        mpf_inits(dividend, divisor, NULL);
-        mpf_init_set(dep_a, factorials[block_start * 6]);
-        mpf_init_set(dep_b, factorials[block_start]);
-        mpf_pow_ui(dep_b, dep_b, 3);
-        mpf_init_set(dep_c, factorials[block_start * 3]);
+        mpf_inits(dep_a, dep_b, dep_c, dep_f, dividend, divisor, NULL);
+        gmp_get_factorial(dep_a, 6 * block_start, checkpoints, num_checkpoints, interval);
+        gmp_get_factorial(dep_f, block_start, checkpoints, num_checkpoints, interval);
+        mpf_pow_ui(dep_b, dep_f, 3);
+        gmp_get_factorial(dep_c, 3 * block_start, checkpoints, num_checkpoints, interval);
+        //The checkpoints are not needed anymore
+        gmp_clear_factorial_checkpoints(checkpoints, num_checkpoints);
         mpf_init_set_ui(dep_d, C);
         mpf_neg(dep_d, dep_d);
         mpf_pow_ui(dep_d, dep_d, block_start * 3);
@@ -120,30 +262,38 @@ void gmp_chudnovsky_all_factorials_blocks_algorithm(mpf_t pi, int num_iterations
         mpf_mul_ui(dep_e, dep_e, block_start);
         mpf_add_ui(dep_e, dep_e, A);
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             gmp_chudnovsky_all_factorials_iteration(local_pi, i, dep_a, dep_b, dep_c, dep_d, dep_e, dividend, divisor);
-            //Update dependencies
-            mpf_set(dep_a, factorials[6 * (i + 1)]);
-            mpf_pow_ui(dep_b, factorials[i + 1], 3);
-            mpf_set(dep_c, factorials[3 * (i + 1)]);
+            //Update dependencies (the factorials are expanded from the previous ones)
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 1);
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 2);
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 3);
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 4);
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 5);
+            mpf_mul_ui(dep_a, dep_a, 6 * i + 6);
+            mpf_mul_ui(dep_f, dep_f, i + 1);
+            mpf_pow_ui(dep_b, dep_f, 3);
+            mpf_mul_ui(dep_c, dep_c, 3 * i + 1);
+            mpf_mul_ui(dep_c, dep_c, 3 * i + 2);
+            mpf_mul_ui(dep_c, dep_c, 3 * i + 3);
             mpf_mul(dep_d, dep_d, c);
             mpf_add_ui(dep_e, dep_e, B);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
-        mpf_clears(local_pi, dep_a, dep_b, dep_c, dep_d, dep_e, dividend, divisor, NULL);   
+        mpf_clears(local_pi, dep_a, dep_b, dep_c, dep_d, dep_e, dep_f, dividend, divisor, NULL);   
+        memory_allocator_release_thread();
     }
 
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_newton_div(pi, e, pi);    
     
     //Clear memory
-    gmp_clear_factorials(factorials, num_factorials);
     mpf_clears(c, e, NULL);
 }
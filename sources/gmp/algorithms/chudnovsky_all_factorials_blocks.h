@@ -1,7 +1,9 @@
 #ifndef GMP_CHUDNOVSKY_ALL_FACTORIALS_BLOCKS
 #define GMP_CHUDNOVSKY_ALL_FACTORIALS_BLOCKS
 
-void gmp_chudnovsky_all_factorials_blocks_algorithm(mpf_t, int, int);
+void gmp_chudnovsky_all_factorials_blocks_algorithm(mpf_t, long, int, int);
+unsigned long gmp_chudnovsky_factorial_checkpoints_bytes(long, int);
+int gmp_chudnovsky_factorial_checkpoints(long, int, unsigned long);
 
 #endif
 
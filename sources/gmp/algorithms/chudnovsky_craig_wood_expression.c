@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <omp.h>
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
+#include "../../common/phase_timers.h"
 
 #define A 13591409
 #define B 545140134
@@ -28,7 +31,7 @@
 /*
  * An iteration of Chudnovsky formula using the binary splitting algorithm
  */
-void gmp_chudnovsky_craig_wood_expression_iteration(int n, mpf_t sum_a, mpf_t sum_b, mpf_t a_n, mpf_t b_n, mpf_t a_n_divisor, 
+void gmp_chudnovsky_craig_wood_expression_iteration(long n, mpf_t sum_a, mpf_t sum_b, mpf_t a_n, mpf_t b_n, mpf_t a_n_divisor, 
                                                     mpf_t factor_a, mpf_t factor_b, mpf_t factor_c){
     // Computing a_n
     // factor_a = (6n -5)
@@ -68,27 +71,30 @@ void gmp_chudnovsky_craig_wood_expression_iteration(int n, mpf_t sum_a, mpf_t su
 }
 
 
-void gmp_chudnovsky_craig_wood_expression_algorithm(mpf_t pi, int num_iterations, int num_threads){
-    int i;
+void gmp_chudnovsky_craig_wood_expression_algorithm(mpf_t pi, long num_iterations, int num_threads){
+    long i;
     mpf_t sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c;
 
+    //Sequential: only the thread 0 is timed
+    phase_timers_start(0);
     mpf_inits(sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c, NULL);
     mpf_set_ui(a_n, 1);
     mpf_set_ui(e, E);
     mpf_set_ui(sum_a, 1);
     mpf_set_ui(sum_b, 0);
 
+    phase_timers_lap(0, TIMERS_PHASE_SEED);
     for(i = 1; i < num_iterations; i++){
         gmp_chudnovsky_craig_wood_expression_iteration(i, sum_a, sum_b, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c);
     }
+    phase_timers_lap(0, TIMERS_PHASE_SERIES);
 
     mpf_mul_ui(sum_a, sum_a, A);
     mpf_mul_ui(sum_b, sum_b, B);
     mpf_add(pi, sum_a, sum_b);
     
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_chudnovsky_constant(e);
+    gmp_newton_div(pi, e, pi);    
    
     //Clear memory
     mpf_clears(sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c, NULL);
@@ -1,7 +1,7 @@
 #ifndef GMP_CHUDNOVSKY_CRAIG_WOOD_EXPRESSION
 #define GMP_CHUDNOVSKY_CRAIG_WOOD_EXPRESSION
 
-void gmp_chudnovsky_craig_wood_expression_algorithm(mpf_t, int, int);
+void gmp_chudnovsky_craig_wood_expression_algorithm(mpf_t, long, int);
 
 #endif
 
@@ -2,6 +2,14 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../checkpoint.h"
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
 
 #define A 13591409
 #define B 545140134
@@ -43,7 +51,7 @@
 /*
  * An iteration of Chudnovsky formula
  */
-void gmp_chudnovsky_iteration(mpf_t pi, int n, mpf_t dep_a, mpf_t dep_b, mpf_t dep_c, mpf_t aux){
+void gmp_chudnovsky_iteration(mpf_t pi, long n, mpf_t dep_a, mpf_t dep_b, mpf_t dep_c, mpf_t aux){
     mpf_mul(aux, dep_a, dep_c);
     mpf_div(aux, aux, dep_b);
     
@@ -54,7 +62,7 @@ void gmp_chudnovsky_iteration(mpf_t pi, int n, mpf_t dep_a, mpf_t dep_b, mpf_t d
  * This method is used by chudnovsky threads
  * for computing the first value of dep_a
  */
-void gmp_init_dep_a(mpf_t dep_a, int block_start){
+void gmp_init_dep_a(mpf_t dep_a, long block_start){
     mpz_t factorial_n, dividend, divisor;
     mpf_t float_dividend, float_divisor;
     mpz_inits(factorial_n, dividend, divisor, NULL);
@@ -76,37 +84,64 @@ void gmp_init_dep_a(mpf_t dep_a, int block_start){
     mpf_clears(float_dividend, float_divisor, NULL);
 }
 
-void gmp_chudnovsky_simplified_expression_blocks_algorithm(mpf_t pi, int num_iterations, int num_threads){
+/*
+ * This method computes the constant of the final division: 
+ * e = 426880 sqrt(10005). It is launched as a task while the 
+ * threads are computing the series
+ */
+void gmp_chudnovsky_constant(mpf_t e){
+    mpf_set_ui(e, E);
+    gmp_newton_sqrt(e, e);
+    mpf_mul_ui(e, e, D);
+}
+
+void gmp_chudnovsky_simplified_expression_blocks_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t e, c;
     
-    mpf_init_set_ui(e, E);
+    mpf_init(e);
     mpf_init_set_ui(c, C);
     mpf_neg(c, c);
     mpf_pow_ui(c, c, 3);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_size, block_start, block_end, factor_a;
+        int thread_id;
+        long i, block_start, block_end, factor_a;
         mpf_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
         
         mpf_inits(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
-        mpf_set_ui(local_pi, 0);    // private thread pi
-        gmp_init_dep_a(dep_a, block_start);
-        mpf_pow_ui(dep_b, c, block_start);
-        mpf_set_ui(dep_c, B);
-        mpf_mul_ui(dep_c, dep_c, block_start);
-        mpf_add_ui(dep_c, dep_c, A);
+        mpf_ptr state[] = {local_pi, dep_a, dep_b, dep_c};
+
+        //With -resume the thread goes on from its checkpoint
+        if(!gmp_checkpoint_load(thread_id, &block_start, state, 4, NULL, 0)){
+            mpf_set_ui(local_pi, 0);    // private thread pi
+            gmp_init_dep_a(dep_a, block_start);
+            mpf_pow_ui(dep_b, c, block_start);
+            mpf_set_ui(dep_c, B);
+            mpf_mul_ui(dep_c, dep_c, block_start);
+            mpf_add_ui(dep_c, dep_c, A);
+        }
         factor_a = 12 * block_start;
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             gmp_chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
@@ -127,19 +162,21 @@ void gmp_chudnovsky_simplified_expression_blocks_algorithm(mpf_t pi, int num_ite
 
             //Update dep_c:
             mpf_add_ui(dep_c, dep_c, B);
+
+            //Checkpoint of the state before the iteration i + 1 (written by another thread)
+            if(checkpoint_due(thread_id)) gmp_checkpoint_save(thread_id, i + 1, state, 4, NULL, 0);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
         mpf_clears(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_newton_div(pi, e, pi);    
     
     //Clear memory
     mpf_clears(c, e, NULL);
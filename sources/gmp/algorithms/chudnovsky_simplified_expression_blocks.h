@@ -1,9 +1,10 @@
 #ifndef GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_BLOCKS
 #define GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_BLOCKS
 
-void gmp_chudnovsky_simplified_expression_blocks_algorithm(mpf_t, int, int);
-void gmp_chudnovsky_iteration(mpf_t, int, mpf_t, mpf_t, mpf_t, mpf_t);
-void gmp_init_dep_a(mpf_t, int);
+void gmp_chudnovsky_simplified_expression_blocks_algorithm(mpf_t, long, int);
+void gmp_chudnovsky_iteration(mpf_t, long, mpf_t, mpf_t, mpf_t, mpf_t);
+void gmp_init_dep_a(mpf_t, long);
+void gmp_chudnovsky_constant(mpf_t);
 
 #endif
 
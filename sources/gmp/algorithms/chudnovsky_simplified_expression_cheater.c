@@ -3,6 +3,11 @@
 #include <gmp.h>
 #include <omp.h>
 #include "chudnovsky_simplified_expression_blocks.h"
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../newton.h"
 
 
 #define A 13591409
@@ -52,8 +57,9 @@
  *   distribution[1] -> block start
  *   distribution[2] -> block end 
  */
-int * get_thread_distribution(int num_threads, int thread_id, int num_iterations){
-    int * distribution, i, block_size, block_start, block_end, row, column; 
+long * get_thread_distribution(int num_threads, int thread_id, long num_iterations){
+    long * distribution, block_size, block_start, block_end;
+    int i, row, column; 
     FILE * ratios_file;
     float working_ratios[160][41];
 
@@ -73,7 +79,7 @@ int * get_thread_distribution(int num_threads, int thread_id, int num_iterations
         row++;
     }
 
-    distribution = malloc(sizeof(int) * 3);
+    distribution = malloc(sizeof(long) * 3);
     if(num_threads == 1){
         distribution[0] = num_iterations;
         distribution[1] = 0;
@@ -98,23 +104,35 @@ int * get_thread_distribution(int num_threads, int thread_id, int num_iterations
 
 
 
-void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t e, c;
 
-    mpf_init_set_ui(e, E);
+    mpf_init(e);
     mpf_init_set_ui(c, C);
     mpf_neg(c, c);
     mpf_pow_ui(c, c, 3);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_size, block_start, block_end, factor_a, * distribution;
+        int thread_id;
+        long i, block_size, block_start, block_end, factor_a, * distribution;
         mpf_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
         distribution = get_thread_distribution(num_threads, thread_id, num_iterations);
         block_size = distribution[0];
         block_start = distribution[1];
@@ -129,6 +147,8 @@ void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t pi, int num_it
         mpf_add_ui(dep_c, dep_c, A);
         factor_a = 12 * block_start;
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             gmp_chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
@@ -149,18 +169,17 @@ void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t pi, int num_it
             //Update dep_c:
             mpf_add_ui(dep_c, dep_c, B);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
         mpf_clears(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_newton_div(pi, e, pi);    
     
     //Clear memory
     mpf_clears(c, e, NULL);
@@ -1,7 +1,7 @@
 #ifndef GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_CHEATER
 #define GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_CHEATER
 
-void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t, int, int);
+void gmp_chudnovsky_simplified_expression_cheater_algorithm(mpf_t, long, int);
 
 #endif
 
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <omp.h>
+#include "../reduction.h"
+#include "../../common/iterations.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
+
+#define A 13591409
+#define B 545140134
+#define C 640320
+#define D 426880
+#define E 10005
+#define RATIO_LEAF_TERMS 16     // Terms multiplied sequentially in the leaves of the product tree
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Chudnovsky formula implementation                                                *
+ * This version does not computes all the factorials (the expression is simplified) *
+ * This version uses a cyclic or a block-cyclic distribution                        *
+ * It allows to compute pi using multiple threads                                   *
+ *                                                                                  *
+ ************************************************************************************
+ * Chudnovsky formula:                                                              *
+ *     426880 sqrt(10005)                 (6n)! (545140134n + 13591409)             *
+ *    --------------------  = SUMMATORY( ----------------------------- ),  n >=0    *
+ *            pi                            (n!)^3 (3n)! (-640320)^3n               *
+ *                                                                                  *
+ * Each thread computes the blocks of k terms thread_id, thread_id + num_threads,   *
+ * thread_id + 2 num_threads... (k = 1 for the cyclic distribution, k = 16 or the   *
+ * value of -block-size for the block-cyclic one), so the cost of the terms is      *
+ * balanced among threads                                                           *
+ *                                                                                  *
+ ************************************************************************************
+ * Chudnovsky formula dependencies (jump of j terms):                               *
+ *                                   m+j-1  (12i + 10)(12i + 6)(12i + 2)            *
+ *      dep_a(m + j) = dep_a(m) PRODUCT(  ----------------------------  )           *
+ *                                    i=m           (i + 1)^3                       *
+ *                                                                                  *
+ *      dep_b(m + j) = dep_b(m) (-640320)^3j                                        *
+ *                                                                                  *
+ *      dep_c(m + j) = dep_c(m) + 545140134 j                                       *
+ *                                                                                  *
+ * Inside a block j = 1. At the end of a block the thread jumps to its next block   *
+ * (j = (num_threads - 1) k + 1). The multipliers of dep_b and dep_c are            *
+ * precomputed and the products of dep_a are computed with a product tree           *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Computes the products of the jump of dep_a from the term "from" with a
+ * product tree:
+ *      numerator = PRODUCT((12i + 10)(12i + 6)(12i + 2))
+ *      denominator_root = PRODUCT(i + 1)
+ */
+void gmp_chudnovsky_dep_a_products(mpz_t numerator, mpz_t denominator_root, unsigned long from, unsigned long terms){
+    unsigned long i, half;
+    mpz_t right_numerator, right_denominator_root;
+
+    if(terms <= RATIO_LEAF_TERMS){
+        mpz_set_ui(numerator, 1);
+        mpz_set_ui(denominator_root, 1);
+        for(i = from; i < from + terms; i++){
+            mpz_mul_ui(numerator, numerator, 12 * i + 10);
+            mpz_mul_ui(numerator, numerator, 12 * i + 6);
+            mpz_mul_ui(numerator, numerator, 12 * i + 2);
+            mpz_mul_ui(denominator_root, denominator_root, i + 1);
+        }
+        return;
+    }
+
+    half = terms / 2;
+    mpz_inits(right_numerator, right_denominator_root, NULL);
+    gmp_chudnovsky_dep_a_products(numerator, denominator_root, from, half);
+    gmp_chudnovsky_dep_a_products(right_numerator, right_denominator_root, from + half, terms - half);
+    mpz_mul(numerator, numerator, right_numerator);
+    mpz_mul(denominator_root, denominator_root, right_denominator_root);
+    mpz_clears(right_numerator, right_denominator_root, NULL);
+}
+
+/*
+ * dep_a = dep_a(from + terms), being dep_a = dep_a(from)
+ */
+void gmp_chudnovsky_jump_dep_a(mpf_t dep_a, unsigned long from, unsigned long terms){
+    mpz_t numerator, denominator;
+    mpf_t float_numerator, float_denominator;
+
+    mpz_inits(numerator, denominator, NULL);
+    mpf_inits(float_numerator, float_denominator, NULL);
+
+    gmp_chudnovsky_dep_a_products(numerator, denominator, from, terms);
+    mpz_pow_ui(denominator, denominator, 3);
+
+    mpf_set_z(float_numerator, numerator);
+    mpf_set_z(float_denominator, denominator);
+    mpf_mul(dep_a, dep_a, float_numerator);
+    mpf_div(dep_a, dep_a, float_denominator);
+
+    mpz_clears(numerator, denominator, NULL);
+    mpf_clears(float_numerator, float_denominator, NULL);
+}
+
+void gmp_chudnovsky_simplified_expression_block_cyclic(mpf_t pi, long num_iterations, int num_threads, long block_size){
+    unsigned long jump_size;
+    mpf_t e, c, jump_c;
+
+    mpf_init(e);
+    mpf_init_set_ui(c, C);
+    mpf_neg(c, c);
+    mpf_pow_ui(c, c, 3);
+
+    //From the last term of a block to the first term of the next block of the thread
+    jump_size = (unsigned long) (num_threads - 1) * block_size + 1;
+    mpf_init(jump_c);
+    mpf_pow_ui(jump_c, c, jump_size);
+
+    mpf_ptr partials[num_threads];
+
+    //Set the number of threads
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel
+    {
+        int thread_id;
+        long i, block_start, block_end;
+        mpf_t local_pi, dep_a, dep_b, dep_c, aux;
+
+        thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
+        block_start = (long) thread_id * block_size;
+
+        mpf_inits(local_pi, dep_a, dep_b, dep_c, aux, NULL);
+        mpf_set_ui(local_pi, 0);    // private thread pi
+        gmp_init_dep_a(dep_a, block_start);
+        mpf_pow_ui(dep_b, c, block_start);
+        mpf_set_ui(dep_c, B);
+        mpf_mul_ui(dep_c, dep_c, block_start);
+        mpf_add_ui(dep_c, dep_c, A);
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
+        //First Phase -> Working on a local variable
+        for(; block_start < num_iterations; block_start += (long) num_threads * block_size){
+            block_end = block_start + block_size;
+            if (block_end > num_iterations) block_end = num_iterations;
+
+            for(i = block_start; i < block_end; i++){
+                gmp_chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
+
+                if(i < block_end - 1){
+                    //Update dependencies to the next term
+                    gmp_chudnovsky_jump_dep_a(dep_a, i, 1);
+                    mpf_mul(dep_b, dep_b, c);
+                    mpf_add_ui(dep_c, dep_c, B);
+                } else if(block_start + (long) num_threads * block_size < num_iterations){
+                    //Jump to the first term of the next block
+                    gmp_chudnovsky_jump_dep_a(dep_a, i, jump_size);
+                    mpf_mul(dep_b, dep_b, jump_c);
+                    mpf_add_ui(dep_c, dep_c, B * jump_size);
+                }
+            }
+        }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
+
+        //Second Phase -> Accumulate the result in the global variable
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
+
+        //Clear thread memory
+        mpf_clears(local_pi, dep_a, dep_b, dep_c, aux, NULL);
+        memory_allocator_release_thread();
+    }
+
+    gmp_newton_div(pi, e, pi);
+
+    //Clear memory
+    mpf_clears(c, e, jump_c, NULL);
+}
+
+void gmp_chudnovsky_simplified_expression_cyclic_algorithm(mpf_t pi, long num_iterations, int num_threads){
+    gmp_chudnovsky_simplified_expression_block_cyclic(pi, num_iterations, num_threads, 1);
+}
+
+void gmp_chudnovsky_simplified_expression_block_cyclic_algorithm(mpf_t pi, long num_iterations, int num_threads){
+    gmp_chudnovsky_simplified_expression_block_cyclic(pi, num_iterations, num_threads, iterations_block_cyclic_size());
+}
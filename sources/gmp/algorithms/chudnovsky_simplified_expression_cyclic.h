@@ -0,0 +1,8 @@
+#ifndef GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_CYCLIC
+#define GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_CYCLIC
+
+void gmp_chudnovsky_simplified_expression_cyclic_algorithm(mpf_t, long, int);
+void gmp_chudnovsky_simplified_expression_block_cyclic_algorithm(mpf_t, long, int);
+void gmp_chudnovsky_jump_dep_a(mpf_t, unsigned long, unsigned long);
+
+#endif
@@ -2,6 +2,14 @@
 #include <stdlib.h>
 #include <gmp.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../checkpoint.h"
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
 
 #define A 13591409
 #define B 545140134
@@ -45,7 +53,7 @@
 /*
  * An iteration of Chudnovsky formula using the binary splitting algorithm
  */
-void gmp_chudnovsky_simplified_expression_integers_iteration(mpf_t pi, int n, mpz_t dep_a, mpz_t dep_b, mpz_t dep_c, mpz_t aux, 
+void gmp_chudnovsky_simplified_expression_integers_iteration(mpf_t pi, long n, mpz_t dep_a, mpz_t dep_b, mpz_t dep_c, mpz_t aux, 
                                                              mpf_t float_aux, mpf_t float_dep_b){
     mpz_mul(aux, dep_a, dep_c);
  
@@ -56,7 +64,7 @@ void gmp_chudnovsky_simplified_expression_integers_iteration(mpf_t pi, int n, mp
     mpf_add(pi, pi, float_aux);
 }
 
-void mpz_compute_dep_a_gmp(mpz_t dep_a, int n){
+void mpz_compute_dep_a_gmp(mpz_t dep_a, long n){
     mpz_t factorial_n, dividend, divisor;
     mpz_inits(factorial_n, dividend, divisor, NULL);
 
@@ -73,40 +81,57 @@ void mpz_compute_dep_a_gmp(mpz_t dep_a, int n){
 }
 
 
-void gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t e;
     mpz_t c;
 
-    mpf_init_set_ui(e, E);
+    mpf_init(e);
     mpz_init_set_ui(c, C);
     mpz_neg(c, c);
     mpz_pow_ui(c, c, 3);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_size, block_start, block_end, factor_a;
+        int thread_id;
+        long i, block_start, block_end, factor_a;
         mpf_t local_pi, float_aux, float_dep_b;
         mpz_t dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
         
         mpf_init_set_ui(local_pi, 0);    // private thread pi
         mpf_inits(float_aux, float_dep_b, NULL);
-        mpz_inits(dep_a, dep_b, dep_a_dividend, dep_a_divisor, aux, NULL);
-        mpz_compute_dep_a_gmp(dep_a, block_start);
-        mpz_pow_ui(dep_b, c, block_start);
-        mpz_init_set_ui(dep_c, B);
-        mpz_mul_ui(dep_c, dep_c, block_start);
-        mpz_add_ui(dep_c, dep_c, A);
+        mpz_inits(dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
+        mpf_ptr float_state[] = {local_pi};
+        mpz_ptr state[] = {dep_a, dep_b, dep_c};
+
+        //With -resume the thread goes on from its checkpoint
+        if(!gmp_checkpoint_load(thread_id, &block_start, float_state, 1, state, 3)){
+            mpz_compute_dep_a_gmp(dep_a, block_start);
+            mpz_pow_ui(dep_b, c, block_start);
+            mpz_set_ui(dep_c, B);
+            mpz_mul_ui(dep_c, dep_c, block_start);
+            mpz_add_ui(dep_c, dep_c, A);
+        }
         factor_a = 12 * block_start;
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             gmp_chudnovsky_simplified_expression_integers_iteration(local_pi, i, dep_a, dep_b, dep_c, aux, float_aux, float_dep_b);
@@ -126,20 +151,22 @@ void gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(mpf_t pi, in
 
             //Update dep_c:
             mpz_add_ui(dep_c, dep_c, B);
+
+            //Checkpoint of the state before the iteration i + 1 (written by another thread)
+            if(checkpoint_due(thread_id)) gmp_checkpoint_save(thread_id, i + 1, float_state, 1, state, 3);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
         
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
         mpf_clears(local_pi, float_aux, float_dep_b, NULL);  
         mpz_clears(dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);  
+        memory_allocator_release_thread();
     }
 
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_newton_div(pi, e, pi);    
     
     //Clear memory
     mpf_clear(e);
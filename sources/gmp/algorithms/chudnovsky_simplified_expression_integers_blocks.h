@@ -1,7 +1,8 @@
 #ifndef GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_INTEGERS_BLOCKS
 #define GMP_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_INTEGERS_BLOCKS
 
-void gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(mpf_t, int, int);
+void gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(mpf_t, long, int);
+void mpz_compute_dep_a_gmp(mpz_t, long);
 
 #endif
 
@@ -3,6 +3,12 @@
 #include <gmp.h>
 #include <omp.h>
 #include "chudnovsky_simplified_expression_blocks.h"
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../newton.h"
 
 #define A 13591409
 #define B 545140134
@@ -41,9 +47,10 @@
  *                                                                                  *
  ************************************************************************************/
 
-void gmp_chudnovsky_simplified_expression_snake_like_phase(mpf_t local_pi, int block_start, int block_end, mpf_t dep_a, 
-                                                        mpf_t dep_a_dividend, mpf_t dep_a_divisor, mpf_t dep_b, mpf_t dep_c, mpf_t aux, mpf_t c) {
-    int i, factor_a;
+void gmp_chudnovsky_simplified_expression_snake_like_phase(mpf_t local_pi, long block_start, long block_end, mpf_t dep_a, 
+                                                        mpf_t dep_a_dividend, mpf_t dep_a_divisor, mpf_t dep_b, mpf_t dep_c, mpf_t aux, mpf_t c,
+                                                        int thread_id) {
+    long i, factor_a;
 
     gmp_init_dep_a(dep_a, block_start);
     mpf_pow_ui(dep_b, c, block_start);
@@ -51,6 +58,7 @@ void gmp_chudnovsky_simplified_expression_snake_like_phase(mpf_t local_pi, int b
     mpf_mul_ui(dep_c, dep_c, block_start);
     mpf_add_ui(dep_c, dep_c, A);
     factor_a = 12 * block_start;
+    phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
 
     //First Phase -> Working on a local variable        
     for(i = block_start; i < block_end; i++){
@@ -72,51 +80,58 @@ void gmp_chudnovsky_simplified_expression_snake_like_phase(mpf_t local_pi, int b
         //Update dep_c:
         mpf_add_ui(dep_c, dep_c, B);
     } 
-        
+    phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 }
 
-void gmp_chudnovsky_simplified_expression_snake_like_algorithm(mpf_t pi, int num_iterations, int num_threads){
+void gmp_chudnovsky_simplified_expression_snake_like_algorithm(mpf_t pi, long num_iterations, int num_threads){
     mpf_t e, c;
 
-    mpf_init_set_ui(e, E);
+    mpf_init(e);
     mpf_init_set_ui(c, C);
     mpf_neg(c, c);
     mpf_pow_ui(c, c, 3);
 
+    mpf_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, block_size, first_block_start, first_block_end, second_block_start, second_block_end;
+        int thread_id;
+        long first_block_start, first_block_end, second_block_start, second_block_end;
         mpf_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            gmp_chudnovsky_constant(e);
+        }
     
-        block_size = (num_iterations + (num_threads * 2) - 1) / (num_threads * 2);
-        first_block_start = thread_id * block_size;
-        first_block_end = first_block_start + block_size;
-        second_block_start = (thread_id + num_threads) * block_size;
-        second_block_end = second_block_start + block_size;
-        if (second_block_end > num_iterations) second_block_end = num_iterations;
+        iterations_block_bounds(num_iterations, thread_id, num_threads * 2, &first_block_start, &first_block_end);
+        iterations_block_bounds(num_iterations, thread_id + num_threads, num_threads * 2, &second_block_start, &second_block_end);
 
         mpf_init_set_ui(local_pi, 0);    // private thread pi
         mpf_inits(dep_a, dep_b, dep_a_dividend, dep_a_divisor, aux, NULL);
         
-        gmp_chudnovsky_simplified_expression_snake_like_phase(local_pi, first_block_start, first_block_end, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux, c);
-        gmp_chudnovsky_simplified_expression_snake_like_phase(local_pi, second_block_start, second_block_end, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux, c);
+        //Each block seeds its own dependencies (laps of seed and series inside)
+        gmp_chudnovsky_simplified_expression_snake_like_phase(local_pi, first_block_start, first_block_end, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux, c, thread_id);
+        gmp_chudnovsky_simplified_expression_snake_like_phase(local_pi, second_block_start, second_block_end, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux, c, thread_id);
 
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpf_add(pi, pi, local_pi);
+        gmp_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
         mpf_clears(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);  
+        memory_allocator_release_thread();
     }
 
-    mpf_sqrt(e, e);
-    mpf_mul_ui(e, e, D);
-    mpf_div(pi, e, pi);    
+    gmp_newton_div(pi, e, pi);    
     
     //Clear memory
     mpf_clears(c, e, NULL);
@@ -1,6 +1,7 @@
 #ifndef GMP_CHECK_DECIMALS
 #define GMP_CHECK_DECIMALS
 
-int gmp_check_decimals(mpf_t);
+long gmp_check_decimals(mpf_t, int);
+long gmp_check_hex_digits(mpf_t, long, int, int *);
 
 #endif
\ No newline at end of file
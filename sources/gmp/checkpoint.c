@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "checkpoint.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Checkpoints of the GMP values of a thread (common/checkpoint.c). Each value is   *
+ * stored raw: the size (and the exponent of the floats) followed by the limbs      *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Copies the floats and the integers of thread_id (state before the iteration index)
+ * and hands them to the checkpoint writer. It does nothing if the previous
+ * checkpoint of the thread is still being written
+ */
+void gmp_checkpoint_save(int thread_id, long index, mpf_ptr * floats, int num_floats, mpz_ptr * integers, int num_integers){
+    size_t bytes = 0, limbs;
+    char * buffer, * cursor;
+    int i;
+
+    for(i = 0; i < num_floats; i++){
+        bytes += sizeof(int) + sizeof(mp_exp_t) + abs(floats[i] -> _mp_size) * sizeof(mp_limb_t);
+    }
+    for(i = 0; i < num_integers; i++){
+        bytes += sizeof(int) + mpz_size(integers[i]) * sizeof(mp_limb_t);
+    }
+    buffer = checkpoint_buffer(thread_id, bytes);
+    if(buffer == NULL) return;
+
+    cursor = buffer;
+    for(i = 0; i < num_floats; i++){
+        limbs = abs(floats[i] -> _mp_size);
+        memcpy(cursor, &floats[i] -> _mp_size, sizeof(int));
+        memcpy(cursor + sizeof(int), &floats[i] -> _mp_exp, sizeof(mp_exp_t));
+        cursor += sizeof(int) + sizeof(mp_exp_t);
+        memcpy(cursor, floats[i] -> _mp_d, limbs * sizeof(mp_limb_t));
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    for(i = 0; i < num_integers; i++){
+        limbs = mpz_size(integers[i]);
+        memcpy(cursor, &integers[i] -> _mp_size, sizeof(int));
+        cursor += sizeof(int);
+        memcpy(cursor, mpz_limbs_read(integers[i]), limbs * sizeof(mp_limb_t));
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    checkpoint_submit(thread_id, index, bytes);
+}
+
+static void gmp_checkpoint_corrupted(int thread_id){
+    printf("  The checkpoint of the thread %d does not match the execution \n\n", thread_id);
+    exit(-1);
+}
+
+/*
+ * Restores the floats and the integers of thread_id from its checkpoint (-resume).
+ * Returns 1 and the next iteration in index, or 0 if the thread has no checkpoint
+ */
+int gmp_checkpoint_load(int thread_id, long * index, mpf_ptr * floats, int num_floats, mpz_ptr * integers, int num_integers){
+    size_t bytes, limbs;
+    char * buffer, * cursor, * end;
+    int i, size;
+
+    buffer = checkpoint_load(thread_id, index, &bytes);
+    if(buffer == NULL) return 0;
+
+    cursor = buffer;
+    end = buffer + bytes;
+    for(i = 0; i < num_floats; i++){
+        if(cursor + sizeof(int) + sizeof(mp_exp_t) > end) gmp_checkpoint_corrupted(thread_id);
+        memcpy(&size, cursor, sizeof(int));
+        limbs = abs(size);
+        if(limbs > (size_t) floats[i] -> _mp_prec + 1 || cursor + sizeof(int) + sizeof(mp_exp_t) + limbs * sizeof(mp_limb_t) > end) gmp_checkpoint_corrupted(thread_id);
+        floats[i] -> _mp_size = size;
+        memcpy(&floats[i] -> _mp_exp, cursor + sizeof(int), sizeof(mp_exp_t));
+        cursor += sizeof(int) + sizeof(mp_exp_t);
+        memcpy(floats[i] -> _mp_d, cursor, limbs * sizeof(mp_limb_t));
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    for(i = 0; i < num_integers; i++){
+        if(cursor + sizeof(int) > end) gmp_checkpoint_corrupted(thread_id);
+        memcpy(&size, cursor, sizeof(int));
+        limbs = abs(size);
+        cursor += sizeof(int);
+        if(cursor + limbs * sizeof(mp_limb_t) > end) gmp_checkpoint_corrupted(thread_id);
+        memcpy(mpz_limbs_write(integers[i], limbs), cursor, limbs * sizeof(mp_limb_t));
+        mpz_limbs_finish(integers[i], size);
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    free(buffer);
+    return 1;
+}
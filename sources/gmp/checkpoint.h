@@ -0,0 +1,9 @@
+#ifndef GMP_CHECKPOINT
+#define GMP_CHECKPOINT
+
+#include "../common/checkpoint.h"
+
+void gmp_checkpoint_save(int, long, mpf_ptr *, int, mpz_ptr *, int);
+int gmp_checkpoint_load(int, long *, mpf_ptr *, int, mpz_ptr *, int);
+
+#endif
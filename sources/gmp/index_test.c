@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "../common/index_test.h"
+#include "../common/iterations.h"
+#include "algorithms/bbp_cyclic.h"
+#include "algorithms/bellard_recursive_power_cyclic.h"
+#include "algorithms/chudnovsky_simplified_expression_blocks.h"
+#include "algorithms/chudnovsky_simplified_expression_cyclic.h"
+#include "algorithms/chudnovsky_simplified_expression_integers_blocks.h"
+#include "index_test.h"
+
+
+#define QUOTIENT 0.0625
+#define A 13591409
+#define B 545140134
+#define C 640320
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Index test of the engines of GMP (see common/index_test.c)                       *
+ *                                                                                  *
+ ************************************************************************************
+ * The functions of the engines are called at the biggest indices of the execution  *
+ * with INDEX_TEST_PRECISION_BITS, and their dependencies are seeded as the         *
+ * engines seed them:                                                               *
+ *                                                                                  *
+ *      BBP:            dep_m = (1/16)^n, term n - 1                                *
+ *      Bellard:        dep_m = (-1)^n / 1024^n and 2^10n, term n - 1               *
+ *      Chudnovsky:     dep_a (mpf and mpz), dep_b and dep_c at the last block,     *
+ *                      (-640320)^3j and the jump of dep_a of the block-cyclic      *
+ *                      distribution to n - 1, term n - 1                           *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Checks a value of the index test
+ */
+static int gmp_index_test_check(char * name, long n, mpf_t value, long double expected_log2, int expected_sign){
+    double mantissa;
+    long exponent;
+
+    mantissa = mpf_get_d_2exp(&exponent, value);
+    return index_test_check(name, n, mantissa, exponent, expected_log2, expected_sign);
+}
+
+/*
+ * Index test of GMP: calls the functions of the engines at the last terms
+ * of num_bbp, num_bellard and num_chudnovsky iterations with num_threads threads
+ */
+int gmp_index_test(long num_bbp, long num_bellard, long num_chudnovsky, int num_threads){
+    mp_bitcnt_t default_precision = mpf_get_default_prec();
+    long n, seed, block_start, block_end;
+    unsigned long jump_size, from;
+    mpf_t term, quotient, dep_m, dep_a, dep_b, dep_c, c, jump_c, a, b, d, e, f, g, h, aux;
+    mpz_t dep_a_integer;
+    double mantissa;
+    long exponent;
+    long double expected_log2;
+    int ok = 1, sign;
+
+    mpf_set_default_prec(INDEX_TEST_PRECISION_BITS);
+    mpf_inits(term, quotient, dep_m, dep_a, dep_b, dep_c, c, jump_c, a, b, d, e, f, g, h, aux, NULL);
+    mpz_init(dep_a_integer);
+
+    //BBP: last term, with the seed of the blocks (no terms with the smallest precisions)
+    if (num_bbp > 0) {
+        n = num_bbp - 1;
+        mpf_set_d(quotient, QUOTIENT);
+        mpf_pow_ui(dep_m, quotient, n);
+        mpf_set_ui(term, 0);
+        gmp_bbp_iteration(term, n, dep_m, a, b, d, e, aux);
+        ok &= gmp_index_test_check("GMP BBP term (n)", n, term, index_test_log2_bbp_term(n), 1);
+    }
+
+    //Bellard: last term, with the seeds of the recursive power and the bit shift power
+    if (num_bellard > 0) {
+        n = num_bellard - 1;
+        mpf_set_ui(dep_m, 1);
+        mpf_div_ui(dep_m, dep_m, 1024);
+        mpf_pow_ui(dep_m, dep_m, n);
+        if(n % 2 != 0) mpf_neg(dep_m, dep_m);
+        mpf_set_ui(term, 0);
+        gmp_bellard_iteration(term, n, dep_m, a, b, d, e, f, g, h, aux, 4 * n, 10 * n);
+        expected_log2 = index_test_log2_bellard_term(n, &sign);
+        ok &= gmp_index_test_check("GMP Bellard term (n)", n, term, expected_log2, sign);
+        mpf_set_ui(aux, 1);
+        mpf_mul_2exp(dep_m, aux, 10 * n);
+        ok &= gmp_index_test_check("GMP Bellard shift 2^10n (n)", n, dep_m, 10.0L * n, 1);
+    }
+
+    //Chudnovsky: seeds of the last block
+    mpf_set_ui(c, C);
+    mpf_neg(c, c);
+    mpf_pow_ui(c, c, 3);
+    iterations_block_bounds(num_chudnovsky, num_threads - 1, num_threads, &block_start, &block_end);
+    seed = (block_start < INDEX_TEST_SEED_MAX) ? block_start : INDEX_TEST_SEED_MAX;
+    gmp_init_dep_a(dep_a, seed);
+    ok &= gmp_index_test_check("GMP Chudnovsky seed dep_a (n)", seed, dep_a, index_test_log2_dep_a(seed), 1);
+    mpz_compute_dep_a_gmp(dep_a_integer, seed);
+    mantissa = mpz_get_d_2exp(&exponent, dep_a_integer);
+    ok &= index_test_check("GMP Chudnovsky seed dep_a integers (n)", seed, mantissa, exponent, index_test_log2_dep_a(seed), 1);
+    mpf_pow_ui(dep_b, c, block_start);
+    ok &= gmp_index_test_check("GMP Chudnovsky seed dep_b (n)", block_start, dep_b, index_test_log2_dep_b(block_start), (block_start % 2 != 0) ? -1 : 1);
+    mpf_set_ui(dep_c, B);
+    mpf_mul_ui(dep_c, dep_c, block_start);
+    mpf_add_ui(dep_c, dep_c, A);
+    ok &= gmp_index_test_check("GMP Chudnovsky seed dep_c (n)", block_start, dep_c, index_test_log2_dep_c(block_start), 1);
+
+    //Chudnovsky: jump of the block-cyclic distribution to the last term
+    n = num_chudnovsky - 1;
+    jump_size = (unsigned long) (num_threads - 1) * iterations_block_cyclic_size() + 1;
+    mpf_pow_ui(jump_c, c, jump_size);
+    ok &= gmp_index_test_check("GMP Chudnovsky jump (-640320)^3j (j)", jump_size, jump_c, index_test_log2_dep_b(jump_size), (jump_size % 2 != 0) ? -1 : 1);
+    from = ((unsigned long) n > jump_size) ? n - jump_size : 0;
+    mpf_set_ui(dep_a, 1);
+    gmp_chudnovsky_jump_dep_a(dep_a, from, n - from);
+    ok &= gmp_index_test_check("GMP Chudnovsky jump dep_a (n)", n, dep_a, index_test_log2_dep_a_jump(from, n - from), 1);
+
+    //Chudnovsky: last term (relative to dep_a(from))
+    mpf_pow_ui(dep_b, c, n);
+    mpf_set_ui(dep_c, B);
+    mpf_mul_ui(dep_c, dep_c, n);
+    mpf_add_ui(dep_c, dep_c, A);
+    mpf_set_ui(term, 0);
+    gmp_chudnovsky_iteration(term, n, dep_a, dep_b, dep_c, aux);
+    ok &= gmp_index_test_check("GMP Chudnovsky term (n)", n, term, index_test_log2_dep_a_jump(from, n - from)
+                               + index_test_log2_dep_c(n) - index_test_log2_dep_b(n), (n % 2 != 0) ? -1 : 1);
+
+    mpf_clears(term, quotient, dep_m, dep_a, dep_b, dep_c, c, jump_c, a, b, d, e, f, g, h, aux, NULL);
+    mpz_clear(dep_a_integer);
+    mpf_set_default_prec(default_precision);
+    return ok;
+}
@@ -0,0 +1,6 @@
+#ifndef GMP_INDEX_TEST
+#define GMP_INDEX_TEST
+
+int gmp_index_test(long, long, long, int);
+
+#endif
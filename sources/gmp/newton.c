@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <math.h>
+#include <omp.h>
+#include "parallel_multiplication.h"
+
+
+#define NEWTON_MIN_PRECISION 48         // Bits given by the double precision seed
+#define NEWTON_GUARD_BITS 64
+#define NEWTON_STEP_GUARD_BITS 16      // Keeps the bits lost by rounding from doubling at each step
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Newton based reciprocal, inverse square root, square root and division           *
+ * They are used to compute the final division of the Chudnovsky algorithms         *
+ *                                                                                  *
+ ************************************************************************************
+ * Newton iterations (the precision is doubled at each step):                       *
+ *                                                                                  *
+ *      reciprocal:           x(k+1) = x(k) + x(k) (1 - a x(k))                     *
+ *                                                                                  *
+ *      inverse sqrt:         y(k+1) = y(k) + y(k) (1 - a y(k)^2) / 2               *
+ *                                                                                  *
+ *      The last step of the square root and the division is done over the result   *
+ *      (Karp-Markstein), with the inverse computed to half of the precision        *
+ *                                                                                  *
+ * Each step works with the precision it needs, so the total cost is about the      *
+ * cost of the last step. The products of the steps are performed with              *
+ * gmp_parallel_mpf_mul, which uses all the threads for the big products            *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Returns in precisions[] the precision (in bits) of each Newton step, 
+ * from the last one to the first one, and the number of steps
+ */
+int gmp_newton_precisions(mp_bitcnt_t * precisions, mp_bitcnt_t target_precision){
+    int steps = 0;
+    mp_bitcnt_t precision = target_precision + NEWTON_GUARD_BITS;
+
+    while(precision > NEWTON_MIN_PRECISION){
+        precisions[steps++] = precision;
+        precision = precision / 2 + NEWTON_STEP_GUARD_BITS;
+    }
+    return steps;
+}
+
+/*
+ * r = 1 / a
+ */
+void gmp_newton_reciprocal(mpf_t r, mpf_t a){
+    int i, steps;
+    long exponent;
+    double seed;
+    mp_bitcnt_t precisions[64];
+    mpf_t x, t, a_truncated;
+
+    steps = gmp_newton_precisions(precisions, mpf_get_prec(r));
+
+    //Seed: a = seed * 2^exponent -> 1/a = (1/seed) * 2^(-exponent)
+    seed = mpf_get_d_2exp(&exponent, a);
+    mpf_init2(x, NEWTON_MIN_PRECISION);
+    mpf_set_d(x, 1.0 / seed);
+    if(exponent > 0) mpf_div_2exp(x, x, exponent);
+    else mpf_mul_2exp(x, x, -exponent);
+
+    mpf_init2(t, NEWTON_MIN_PRECISION);
+    mpf_init2(a_truncated, NEWTON_MIN_PRECISION);
+    for(i = steps - 1; i >= 0; i--){
+        mpf_set_prec(x, precisions[i]);
+        mpf_set_prec(t, precisions[i]);
+        mpf_set_prec(a_truncated, precisions[i]);
+        mpf_set(a_truncated, a);
+
+        gmp_parallel_mpf_mul(t, a_truncated, x);  // t = a x
+        mpf_ui_sub(t, 1, t);                // t = 1 - a x
+        gmp_parallel_mpf_mul(t, x, t);            // t = x (1 - a x)
+        mpf_add(x, x, t);
+    }
+    mpf_set(r, x);
+
+    mpf_clears(x, t, a_truncated, NULL);
+}
+
+/*
+ * r = 1 / sqrt(a), a > 0
+ */
+void gmp_newton_inverse_sqrt(mpf_t r, mpf_t a){
+    int i, steps;
+    long exponent;
+    double seed;
+    mp_bitcnt_t precisions[64];
+    mpf_t y, t, a_truncated;
+
+    steps = gmp_newton_precisions(precisions, mpf_get_prec(r));
+
+    //Seed: a = seed * 2^exponent (exponent even) -> 1/sqrt(a) = (1/sqrt(seed)) * 2^(-exponent/2)
+    seed = mpf_get_d_2exp(&exponent, a);
+    if(exponent % 2 != 0){
+        seed *= 2;
+        exponent--;
+    }
+    mpf_init2(y, NEWTON_MIN_PRECISION);
+    mpf_set_d(y, 1.0 / sqrt(seed));
+    if(exponent > 0) mpf_div_2exp(y, y, exponent / 2);
+    else mpf_mul_2exp(y, y, -exponent / 2);
+
+    mpf_init2(t, NEWTON_MIN_PRECISION);
+    mpf_init2(a_truncated, NEWTON_MIN_PRECISION);
+    for(i = steps - 1; i >= 0; i--){
+        mpf_set_prec(y, precisions[i]);
+        mpf_set_prec(t, precisions[i]);
+        mpf_set_prec(a_truncated, precisions[i]);
+        mpf_set(a_truncated, a);
+
+        gmp_parallel_mpf_mul(t, y, y);            // t = y^2
+        gmp_parallel_mpf_mul(t, a_truncated, t);  // t = a y^2
+        mpf_ui_sub(t, 1, t);                // t = 1 - a y^2
+        gmp_parallel_mpf_mul(t, y, t);            // t = y (1 - a y^2)
+        mpf_div_2exp(t, t, 1);
+        mpf_add(y, y, t);
+    }
+    mpf_set(r, y);
+
+    mpf_clears(y, t, a_truncated, NULL);
+}
+
+/*
+ * r = sqrt(a), a > 0. The inverse square root is only computed with half
+ * of the precision, the last step is done directly over the square root (Karp):
+ *      s = a y,   sqrt(a) = s + y (a - s^2) / 2
+ */
+void gmp_newton_sqrt(mpf_t r, mpf_t a){
+    mp_bitcnt_t half_precision;
+    mpf_t y, s, t;
+
+    half_precision = mpf_get_prec(r) / 2 + NEWTON_GUARD_BITS;
+    mpf_init2(y, half_precision);
+    mpf_init2(s, half_precision);
+    mpf_init2(t, mpf_get_prec(r) + NEWTON_GUARD_BITS);
+
+    gmp_newton_inverse_sqrt(y, a);
+    gmp_parallel_mpf_mul(s, a, y);        // s = a y
+    gmp_parallel_mpf_mul(t, s, s);        // t = s^2
+    mpf_sub(t, a, t);               // t = a - s^2
+    mpf_set_prec(t, half_precision);
+    gmp_parallel_mpf_mul(t, y, t);        // t = y (a - s^2)
+    mpf_div_2exp(t, t, 1);
+    mpf_add(r, s, t);
+
+    mpf_clears(y, s, t, NULL);
+}
+
+/*
+ * q = a / b. The reciprocal of b is only computed with half of the precision, 
+ * the last step is done directly over the quotient (Karp-Markstein):
+ *      q0 = a x,   q = q0 + x (a - b q0)
+ */
+void gmp_newton_div(mpf_t q, mpf_t a, mpf_t b){
+    mp_bitcnt_t half_precision;
+    mpf_t x, q0, t;
+
+    half_precision = mpf_get_prec(q) / 2 + NEWTON_GUARD_BITS;
+    mpf_init2(x, half_precision);
+    mpf_init2(q0, half_precision);
+    mpf_init2(t, mpf_get_prec(q) + NEWTON_GUARD_BITS);
+
+    gmp_newton_reciprocal(x, b);
+    gmp_parallel_mpf_mul(q0, a, x);       // q0 = a x
+    gmp_parallel_mpf_mul(t, b, q0);       // t = b q0
+    mpf_sub(t, a, t);               // t = a - b q0
+    mpf_set_prec(t, half_precision);
+    gmp_parallel_mpf_mul(t, x, t);        // t = x (a - b q0)
+    mpf_add(q, q0, t);
+
+    mpf_clears(x, q0, t, NULL);
+}
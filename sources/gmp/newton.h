@@ -0,0 +1,9 @@
+#ifndef GMP_NEWTON
+#define GMP_NEWTON
+
+void gmp_newton_reciprocal(mpf_t, mpf_t);
+void gmp_newton_inverse_sqrt(mpf_t, mpf_t);
+void gmp_newton_sqrt(mpf_t, mpf_t);
+void gmp_newton_div(mpf_t, mpf_t, mpf_t);
+
+#endif
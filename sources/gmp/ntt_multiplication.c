@@ -0,0 +1,752 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <gmp.h>
+#include <omp.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NTT_X86
+#endif
+
+
+#define NTT_PRIMES 3
+#define NTT_MAX_LOG_SIZE 26             // 2-adic order shared by the three primes
+#define NTT_MIN_LOG_SIZE 10
+#define NTT_BLOCK_COLUMNS 16            // Columns gathered by each column transform
+#define NTT_BLOCK_SHIFT 4               // log2(NTT_BLOCK_COLUMNS)
+#define NTT_CARRY_CHUNK 65536           // Coefficients of each parallel carry chunk
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Number theoretic transform multiplication of multi-million limb operands         *
+ *                                                                                  *
+ ************************************************************************************
+ * The operands are split in 32 bit pieces and the product is computed modulo       *
+ * three primes p = k 2^m + 1 (all of them with roots of unity of order 2^26):      *
+ *                                                                                  *
+ *      2013265921 = 15 2^27 + 1      1811939329 = 27 2^26 + 1                      *
+ *      469762049  =  7 2^26 + 1                                                    *
+ *                                                                                  *
+ * Every coefficient of the product is smaller than n 2^64 < p1 p2 p3, so it is     *
+ * recovered with the chinese remainder theorem (Garner) and the carries are        *
+ * propagated to build the result                                                   *
+ *                                                                                  *
+ * The modular arithmetic uses 32 bit Montgomery products: the data is kept in      *
+ * normal form and the roots of unity in Montgomery form (w 2^32 mod p)             *
+ *                                                                                  *
+ * Each transform of size n = n1 n2 is done with the six-step layout over a         *
+ * n1 x n2 matrix (without bit reversal, decimation in frequency for the forward    *
+ * transform and decimation in time for the inverse one):                           *
+ *                                                                                  *
+ *      1. Transform of the n1 columns. Blocks of 16 columns are gathered in a      *
+ *         contiguous buffer, so each butterfly works on 16 consecutive values      *
+ *         that share the same root                                                 *
+ *      2. Multiplication by the twiddle factors w^(row column), fused with step 1  *
+ *      3. Transform of the n2 rows, gathered (transposed) in blocks of 16 rows     *
+ *                                                                                  *
+ * Columns and rows are distributed among the threads with OpenMP. The butterflies  *
+ * use AVX-512 or AVX2 when the processor supports them                             *
+ *                                                                                  *
+ ************************************************************************************/
+
+typedef struct {
+    uint32_t p;             // Modulus
+    uint32_t p_inv;         // p^-1 mod 2^32
+    uint32_t r2;            // 2^64 mod p
+    uint32_t generator;     // Primitive root
+} ntt_prime;
+
+typedef struct {
+    const ntt_prime * prime;
+    size_t n, n1, n2;
+    int log_n, log_n1, log_n2, log_low;
+    uint32_t * column_roots, * column_inverse_roots;    // Roots of each stage (h + j -> w(2h)^j)
+    uint32_t * row_roots, * row_inverse_roots;
+    uint32_t * twiddle_steps, * inverse_twiddle_steps;  // w^(bitrev(row) column) for column < 16
+    uint32_t * low_powers, * high_powers;               // w^e = low[e mod 2^log_low] high[e >> log_low]
+    uint32_t scale;                                     // n^-1 2^32 in Montgomery form
+} ntt_plan;
+
+typedef struct {
+    void (*dif)(uint32_t *, uint32_t *, const uint32_t *, int, size_t, const ntt_prime *);
+    void (*dit)(uint32_t *, uint32_t *, const uint32_t *, int, size_t, const ntt_prime *);
+    void (*mul)(uint32_t *, const uint32_t *, const uint32_t *, int, size_t, const ntt_prime *);
+} ntt_kernels;
+
+static ntt_prime ntt_primes[NTT_PRIMES] = {
+    {2013265921u, 0, 0, 31},
+    {1811939329u, 0, 0, 13},
+    {469762049u, 0, 0, 3}
+};
+
+
+/************************************************************************************
+ * Scalar arithmetic                                                                *
+ ************************************************************************************/
+
+/*
+ * Montgomery product: a b 2^-32 mod p
+ */
+static inline uint32_t ntt_mont_mul(uint32_t a, uint32_t b, const ntt_prime * prime){
+    uint64_t product = (uint64_t) a * b;
+    uint32_t m = (uint32_t) product * prime -> p_inv;
+    uint32_t result = (uint32_t) (product >> 32) - (uint32_t) (((uint64_t) m * prime -> p) >> 32);
+    return ((int32_t) result < 0) ? result + prime -> p : result;
+}
+
+static inline uint32_t ntt_add(uint32_t a, uint32_t b, uint32_t p){
+    uint32_t s = a + b;
+    return (s >= p) ? s - p : s;
+}
+
+static inline uint32_t ntt_sub(uint32_t a, uint32_t b, uint32_t p){
+    return (a >= b) ? a - b : a + p - b;
+}
+
+static uint32_t ntt_pow_mod(uint64_t base, uint64_t exponent, uint32_t p){
+    uint64_t result = 1;
+    base %= p;
+    while(exponent > 0){
+        if(exponent & 1) result = result * base % p;
+        base = base * base % p;
+        exponent >>= 1;
+    }
+    return (uint32_t) result;
+}
+
+static inline uint32_t ntt_to_montgomery(uint32_t a, const ntt_prime * prime){
+    return ntt_mont_mul(a, prime -> r2, prime);
+}
+
+static inline size_t ntt_bit_reverse(size_t x, int bits){
+    size_t result = 0;
+    int i;
+    for(i = 0; i < bits; i++){
+        result = (result << 1) | (x & 1);
+        x >>= 1;
+    }
+    return result;
+}
+
+/*
+ * Computes the Montgomery constants of the primes (only once)
+ */
+static void ntt_init_primes(){
+    int i, j;
+    uint32_t inverse;
+
+    if(ntt_primes[0].p_inv != 0) return;
+    for(i = 0; i < NTT_PRIMES; i++){
+        //Newton iteration over 2-adic integers: each step doubles the correct bits
+        inverse = ntt_primes[i].p;
+        for(j = 0; j < 5; j++) inverse *= 2 - ntt_primes[i].p * inverse;
+        ntt_primes[i].r2 = (uint32_t) ((((unsigned __int128) 1) << 64) % ntt_primes[i].p);
+        ntt_primes[i].p_inv = inverse;
+    }
+}
+
+
+/************************************************************************************
+ * Butterfly kernels. The root of the value i is w[i >> w_shift]: w_shift is 0 when *
+ * each value has its own root and 4 when each root is shared by 16 values (count   *
+ * must be a multiple of 16 in that case)                                           *
+ *                                                                                  *
+ *      dif:  x = x + y,  y = (x - y) w                                             *
+ *      dit:  x = x + y w,  y = x - y w                                             *
+ *      mul:  dst = a w                                                             *
+ ************************************************************************************/
+
+static void ntt_dif_scalar(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    uint32_t a, b;
+    for(i = 0; i < count; i++){
+        a = x[i]; b = y[i];
+        x[i] = ntt_add(a, b, prime -> p);
+        y[i] = ntt_mont_mul(ntt_sub(a, b, prime -> p), w[i >> w_shift], prime);
+    }
+}
+
+static void ntt_dit_scalar(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    uint32_t a, b;
+    for(i = 0; i < count; i++){
+        a = x[i]; b = ntt_mont_mul(y[i], w[i >> w_shift], prime);
+        x[i] = ntt_add(a, b, prime -> p);
+        y[i] = ntt_sub(a, b, prime -> p);
+    }
+}
+
+static void ntt_mul_scalar(uint32_t * dst, const uint32_t * a, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    for(i = 0; i < count; i++){
+        dst[i] = ntt_mont_mul(a[i], w[i >> w_shift], prime);
+    }
+}
+
+#ifdef NTT_X86
+
+/*
+ * Montgomery product of 8 lanes. The even and odd lanes are multiplied separately
+ * (_mm256_mul_epu32) and the high halves are merged at the end
+ */
+__attribute__((target("avx2")))
+static inline __m256i ntt_mont_mul_avx2(__m256i a, __m256i b, __m256i p, __m256i p_inv){
+    __m256i product_even, product_odd, m_even, m_odd, result_even, result_odd, result;
+
+    product_even = _mm256_mul_epu32(a, b);
+    product_odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    m_even = _mm256_mul_epu32(product_even, p_inv);
+    m_odd = _mm256_mul_epu32(product_odd, p_inv);
+    //The low halves cancel out, the high halves hold (a b - m p) / 2^32
+    result_even = _mm256_sub_epi64(product_even, _mm256_mul_epu32(m_even, p));
+    result_odd = _mm256_sub_epi64(product_odd, _mm256_mul_epu32(m_odd, p));
+    result = _mm256_blend_epi32(_mm256_srli_epi64(result_even, 32), result_odd, 0xAA);
+    return _mm256_min_epu32(result, _mm256_add_epi32(result, p));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i ntt_add_avx2(__m256i a, __m256i b, __m256i p){
+    __m256i s = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(s, _mm256_sub_epi32(s, p));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i ntt_sub_avx2(__m256i a, __m256i b, __m256i p){
+    __m256i d = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(d, _mm256_add_epi32(d, p));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i ntt_load_roots_avx2(const uint32_t * w, size_t i, int w_shift){
+    return (w_shift == 0) ? _mm256_loadu_si256((const __m256i *) (w + i)) : _mm256_set1_epi32(w[i >> w_shift]);
+}
+
+__attribute__((target("avx2")))
+static void ntt_dif_avx2(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m256i p = _mm256_set1_epi32(prime -> p), p_inv = _mm256_set1_epi32(prime -> p_inv);
+    __m256i a, b;
+    for(i = 0; i + 8 <= count; i += 8){
+        a = _mm256_loadu_si256((__m256i *) (x + i));
+        b = _mm256_loadu_si256((__m256i *) (y + i));
+        _mm256_storeu_si256((__m256i *) (x + i), ntt_add_avx2(a, b, p));
+        _mm256_storeu_si256((__m256i *) (y + i), ntt_mont_mul_avx2(ntt_sub_avx2(a, b, p), ntt_load_roots_avx2(w, i, w_shift), p, p_inv));
+    }
+    ntt_dif_scalar(x + i, y + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+__attribute__((target("avx2")))
+static void ntt_dit_avx2(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m256i p = _mm256_set1_epi32(prime -> p), p_inv = _mm256_set1_epi32(prime -> p_inv);
+    __m256i a, b;
+    for(i = 0; i + 8 <= count; i += 8){
+        a = _mm256_loadu_si256((__m256i *) (x + i));
+        b = ntt_mont_mul_avx2(_mm256_loadu_si256((__m256i *) (y + i)), ntt_load_roots_avx2(w, i, w_shift), p, p_inv);
+        _mm256_storeu_si256((__m256i *) (x + i), ntt_add_avx2(a, b, p));
+        _mm256_storeu_si256((__m256i *) (y + i), ntt_sub_avx2(a, b, p));
+    }
+    ntt_dit_scalar(x + i, y + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+__attribute__((target("avx2")))
+static void ntt_mul_avx2(uint32_t * dst, const uint32_t * a, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m256i p = _mm256_set1_epi32(prime -> p), p_inv = _mm256_set1_epi32(prime -> p_inv);
+    for(i = 0; i + 8 <= count; i += 8){
+        _mm256_storeu_si256((__m256i *) (dst + i), ntt_mont_mul_avx2(_mm256_loadu_si256((const __m256i *) (a + i)), ntt_load_roots_avx2(w, i, w_shift), p, p_inv));
+    }
+    ntt_mul_scalar(dst + i, a + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+/*
+ * Montgomery product of 16 lanes (same scheme as the AVX2 version)
+ */
+__attribute__((target("avx512f")))
+static inline __m512i ntt_mont_mul_avx512(__m512i a, __m512i b, __m512i p, __m512i p_inv){
+    __m512i product_even, product_odd, m_even, m_odd, result_even, result_odd, result;
+
+    product_even = _mm512_mul_epu32(a, b);
+    product_odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    m_even = _mm512_mul_epu32(product_even, p_inv);
+    m_odd = _mm512_mul_epu32(product_odd, p_inv);
+    result_even = _mm512_sub_epi64(product_even, _mm512_mul_epu32(m_even, p));
+    result_odd = _mm512_sub_epi64(product_odd, _mm512_mul_epu32(m_odd, p));
+    result = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(result_even, 32), result_odd);
+    return _mm512_min_epu32(result, _mm512_add_epi32(result, p));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i ntt_add_avx512(__m512i a, __m512i b, __m512i p){
+    __m512i s = _mm512_add_epi32(a, b);
+    return _mm512_min_epu32(s, _mm512_sub_epi32(s, p));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i ntt_sub_avx512(__m512i a, __m512i b, __m512i p){
+    __m512i d = _mm512_sub_epi32(a, b);
+    return _mm512_min_epu32(d, _mm512_add_epi32(d, p));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i ntt_load_roots_avx512(const uint32_t * w, size_t i, int w_shift){
+    return (w_shift == 0) ? _mm512_loadu_si512((const void *) (w + i)) : _mm512_set1_epi32(w[i >> w_shift]);
+}
+
+__attribute__((target("avx512f")))
+static void ntt_dif_avx512(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m512i p = _mm512_set1_epi32(prime -> p), p_inv = _mm512_set1_epi32(prime -> p_inv);
+    __m512i a, b;
+    for(i = 0; i + 16 <= count; i += 16){
+        a = _mm512_loadu_si512((void *) (x + i));
+        b = _mm512_loadu_si512((void *) (y + i));
+        _mm512_storeu_si512((void *) (x + i), ntt_add_avx512(a, b, p));
+        _mm512_storeu_si512((void *) (y + i), ntt_mont_mul_avx512(ntt_sub_avx512(a, b, p), ntt_load_roots_avx512(w, i, w_shift), p, p_inv));
+    }
+    ntt_dif_avx2(x + i, y + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+__attribute__((target("avx512f")))
+static void ntt_dit_avx512(uint32_t * x, uint32_t * y, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m512i p = _mm512_set1_epi32(prime -> p), p_inv = _mm512_set1_epi32(prime -> p_inv);
+    __m512i a, b;
+    for(i = 0; i + 16 <= count; i += 16){
+        a = _mm512_loadu_si512((void *) (x + i));
+        b = ntt_mont_mul_avx512(_mm512_loadu_si512((void *) (y + i)), ntt_load_roots_avx512(w, i, w_shift), p, p_inv);
+        _mm512_storeu_si512((void *) (x + i), ntt_add_avx512(a, b, p));
+        _mm512_storeu_si512((void *) (y + i), ntt_sub_avx512(a, b, p));
+    }
+    ntt_dit_avx2(x + i, y + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+__attribute__((target("avx512f")))
+static void ntt_mul_avx512(uint32_t * dst, const uint32_t * a, const uint32_t * w, int w_shift, size_t count, const ntt_prime * prime){
+    size_t i;
+    __m512i p = _mm512_set1_epi32(prime -> p), p_inv = _mm512_set1_epi32(prime -> p_inv);
+    for(i = 0; i + 16 <= count; i += 16){
+        _mm512_storeu_si512((void *) (dst + i), ntt_mont_mul_avx512(_mm512_loadu_si512((const void *) (a + i)), ntt_load_roots_avx512(w, i, w_shift), p, p_inv));
+    }
+    ntt_mul_avx2(dst + i, a + i, w + (i >> w_shift), w_shift, count - i, prime);
+}
+
+#endif
+
+/*
+ * Selects the widest kernels supported by the processor
+ */
+static ntt_kernels ntt_select_kernels(){
+    ntt_kernels kernels = {ntt_dif_scalar, ntt_dit_scalar, ntt_mul_scalar};
+#ifdef NTT_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){
+        kernels.dif = ntt_dif_avx512; kernels.dit = ntt_dit_avx512; kernels.mul = ntt_mul_avx512;
+    } else if(__builtin_cpu_supports("avx2")){
+        kernels.dif = ntt_dif_avx2; kernels.dit = ntt_dit_avx2; kernels.mul = ntt_mul_avx2;
+    }
+#endif
+    return kernels;
+}
+
+
+/************************************************************************************
+ * Transforms                                                                       *
+ ************************************************************************************/
+
+/*
+ * Stores in table[h + j] the root w(2h)^j (in Montgomery form) of every stage
+ * of a transform of size 2^log_size whose main root is w
+ */
+static void ntt_stage_roots(uint32_t * table, int log_size, uint32_t w, const ntt_prime * prime){
+    size_t h, j, size = (size_t) 1 << log_size;
+    uint32_t root, power;
+
+    for(h = size / 2; h >= 1; h /= 2){
+        //w(2h) = w^(size / 2h)
+        root = ntt_pow_mod(w, size / (2 * h), prime -> p);
+        power = 1;
+        for(j = 0; j < h; j++){
+            table[h + j] = ntt_to_montgomery(power, prime);
+            power = (uint64_t) power * root % prime -> p;
+        }
+    }
+}
+
+/*
+ * Builds the roots of unity of a transform of size 2^log_n modulo prime
+ */
+static void ntt_init_plan(ntt_plan * plan, int log_n, const ntt_prime * prime){
+    size_t i, c, size;
+    uint32_t w, w_inverse, step, power, n_inverse;
+
+    plan -> prime = prime;
+    plan -> log_n = log_n;
+    plan -> log_n1 = log_n / 2;
+    plan -> log_n2 = log_n - plan -> log_n1;
+    plan -> log_low = (log_n + 1) / 2;
+    plan -> n = (size_t) 1 << log_n;
+    plan -> n1 = (size_t) 1 << plan -> log_n1;
+    plan -> n2 = (size_t) 1 << plan -> log_n2;
+
+    w = ntt_pow_mod(prime -> generator, (prime -> p - 1) >> log_n, prime -> p);
+    w_inverse = ntt_pow_mod(w, prime -> p - 2, prime -> p);
+
+    plan -> column_roots = malloc(plan -> n1 * sizeof(uint32_t));
+    plan -> column_inverse_roots = malloc(plan -> n1 * sizeof(uint32_t));
+    plan -> row_roots = malloc(plan -> n2 * sizeof(uint32_t));
+    plan -> row_inverse_roots = malloc(plan -> n2 * sizeof(uint32_t));
+    ntt_stage_roots(plan -> column_roots, plan -> log_n1, ntt_pow_mod(w, plan -> n2, prime -> p), prime);
+    ntt_stage_roots(plan -> column_inverse_roots, plan -> log_n1, ntt_pow_mod(w_inverse, plan -> n2, prime -> p), prime);
+    ntt_stage_roots(plan -> row_roots, plan -> log_n2, ntt_pow_mod(w, plan -> n1, prime -> p), prime);
+    ntt_stage_roots(plan -> row_inverse_roots, plan -> log_n2, ntt_pow_mod(w_inverse, plan -> n1, prime -> p), prime);
+
+    //Twiddle factors of the first 16 columns of each row
+    plan -> twiddle_steps = malloc(plan -> n1 * NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+    plan -> inverse_twiddle_steps = malloc(plan -> n1 * NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+    for(i = 0; i < plan -> n1; i++){
+        step = ntt_pow_mod(w, ntt_bit_reverse(i, plan -> log_n1), prime -> p);
+        power = 1;
+        for(c = 0; c < NTT_BLOCK_COLUMNS; c++){
+            plan -> twiddle_steps[i * NTT_BLOCK_COLUMNS + c] = ntt_to_montgomery(power, prime);
+            power = (uint64_t) power * step % prime -> p;
+        }
+        step = ntt_pow_mod(w_inverse, ntt_bit_reverse(i, plan -> log_n1), prime -> p);
+        power = 1;
+        for(c = 0; c < NTT_BLOCK_COLUMNS; c++){
+            plan -> inverse_twiddle_steps[i * NTT_BLOCK_COLUMNS + c] = ntt_to_montgomery(power, prime);
+            power = (uint64_t) power * step % prime -> p;
+        }
+    }
+
+    //Two level table of the powers of w
+    size = (size_t) 1 << plan -> log_low;
+    plan -> low_powers = malloc(size * sizeof(uint32_t));
+    power = 1;
+    for(i = 0; i < size; i++){
+        plan -> low_powers[i] = ntt_to_montgomery(power, prime);
+        power = (uint64_t) power * w % prime -> p;
+    }
+    step = power;
+    size = plan -> n >> plan -> log_low;
+    plan -> high_powers = malloc(size * sizeof(uint32_t));
+    power = 1;
+    for(i = 0; i < size; i++){
+        plan -> high_powers[i] = ntt_to_montgomery(power, prime);
+        power = (uint64_t) power * step % prime -> p;
+    }
+
+    //The inverse transform is scaled by n^-1 and compensates the 2^-32 of the pointwise product
+    n_inverse = ntt_pow_mod(plan -> n, prime -> p - 2, prime -> p);
+    plan -> scale = ntt_to_montgomery((uint32_t) ((uint64_t) n_inverse * ((((uint64_t) 1) << 32) % prime -> p) % prime -> p), prime);
+}
+
+static void ntt_clear_plan(ntt_plan * plan){
+    free(plan -> column_roots);
+    free(plan -> column_inverse_roots);
+    free(plan -> row_roots);
+    free(plan -> row_inverse_roots);
+    free(plan -> twiddle_steps);
+    free(plan -> inverse_twiddle_steps);
+    free(plan -> low_powers);
+    free(plan -> high_powers);
+}
+
+/*
+ * w^exponent in Montgomery form
+ */
+static inline uint32_t ntt_root_power(const ntt_plan * plan, size_t exponent){
+    exponent &= plan -> n - 1;
+    return ntt_mont_mul(plan -> low_powers[exponent & (((size_t) 1 << plan -> log_low) - 1)],
+                        plan -> high_powers[exponent >> plan -> log_low], plan -> prime);
+}
+
+/*
+ * Forward (dif) transform of size length over a block of 16 interleaved
+ * sequences (buffer holds length rows of 16 values). Every butterfly works
+ * on 16 consecutive values that share the same root
+ */
+static void ntt_block_dif(uint32_t * buffer, size_t length, const uint32_t * roots, const ntt_prime * prime, const ntt_kernels * kernels){
+    size_t h, s;
+    for(h = length / 2; h >= 1; h /= 2){
+        for(s = 0; s < length; s += 2 * h){
+            kernels -> dif(buffer + s * NTT_BLOCK_COLUMNS, buffer + (s + h) * NTT_BLOCK_COLUMNS,
+                           roots + h, NTT_BLOCK_SHIFT, h * NTT_BLOCK_COLUMNS, prime);
+        }
+    }
+}
+
+/*
+ * Inverse (dit) version of ntt_block_dif
+ */
+static void ntt_block_dit(uint32_t * buffer, size_t length, const uint32_t * roots, const ntt_prime * prime, const ntt_kernels * kernels){
+    size_t h, s;
+    for(h = 1; h < length; h *= 2){
+        for(s = 0; s < length; s += 2 * h){
+            kernels -> dit(buffer + s * NTT_BLOCK_COLUMNS, buffer + (s + h) * NTT_BLOCK_COLUMNS,
+                           roots + h, NTT_BLOCK_SHIFT, h * NTT_BLOCK_COLUMNS, prime);
+        }
+    }
+}
+
+/*
+ * Forward transform (steps 1 and 2) of the block of columns [first_column, first_column + 16).
+ * The block is copied to buffer (n1 rows of 16 values) and copied back at the end
+ */
+static void ntt_forward_columns(uint32_t * data, uint32_t * buffer, size_t first_column, const ntt_plan * plan, const ntt_kernels * kernels){
+    size_t row;
+    uint32_t start, twiddles[NTT_BLOCK_COLUMNS];
+    const ntt_prime * prime = plan -> prime;
+
+    for(row = 0; row < plan -> n1; row++){
+        memcpy(buffer + row * NTT_BLOCK_COLUMNS, data + row * plan -> n2 + first_column, NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+    }
+
+    ntt_block_dif(buffer, plan -> n1, plan -> column_roots, prime, kernels);
+
+    //The row in position r holds the frequency bitrev(r): twiddle w^(bitrev(r) column)
+    for(row = 0; row < plan -> n1; row++){
+        start = ntt_root_power(plan, ntt_bit_reverse(row, plan -> log_n1) * first_column);
+        kernels -> mul(twiddles, plan -> twiddle_steps + row * NTT_BLOCK_COLUMNS, &start, NTT_BLOCK_SHIFT, NTT_BLOCK_COLUMNS, prime);
+        kernels -> mul(data + row * plan -> n2 + first_column, buffer + row * NTT_BLOCK_COLUMNS, twiddles, 0, NTT_BLOCK_COLUMNS, prime);
+    }
+}
+
+/*
+ * Inverse transform (inverse of steps 2 and 1) of the block of columns
+ * [first_column, first_column + 16). The result is scaled by n^-1 2^32
+ */
+static void ntt_inverse_columns(uint32_t * data, uint32_t * buffer, size_t first_column, const ntt_plan * plan, const ntt_kernels * kernels){
+    size_t row;
+    uint32_t start, twiddles[NTT_BLOCK_COLUMNS];
+    const ntt_prime * prime = plan -> prime;
+
+    for(row = 0; row < plan -> n1; row++){
+        start = ntt_root_power(plan, plan -> n - ((ntt_bit_reverse(row, plan -> log_n1) * first_column) & (plan -> n - 1)));
+        start = ntt_mont_mul(start, plan -> scale, prime);
+        kernels -> mul(twiddles, plan -> inverse_twiddle_steps + row * NTT_BLOCK_COLUMNS, &start, NTT_BLOCK_SHIFT, NTT_BLOCK_COLUMNS, prime);
+        kernels -> mul(buffer + row * NTT_BLOCK_COLUMNS, data + row * plan -> n2 + first_column, twiddles, 0, NTT_BLOCK_COLUMNS, prime);
+    }
+
+    ntt_block_dit(buffer, plan -> n1, plan -> column_inverse_roots, prime, kernels);
+
+    for(row = 0; row < plan -> n1; row++){
+        memcpy(data + row * plan -> n2 + first_column, buffer + row * NTT_BLOCK_COLUMNS, NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+    }
+}
+
+/*
+ * Forward (dif) or inverse (dit) transform (step 3) of the block of rows
+ * [first_row, first_row + 16). The rows are transposed into buffer (n2 rows
+ * of 16 values), so the last stages are vectorized as well as the first ones
+ */
+static void ntt_transform_rows(uint32_t * data, uint32_t * buffer, size_t first_row, int inverse, const ntt_plan * plan, const ntt_kernels * kernels){
+    size_t row, column;
+    uint32_t * source;
+
+    for(row = 0; row < NTT_BLOCK_COLUMNS; row++){
+        source = data + (first_row + row) * plan -> n2;
+        for(column = 0; column < plan -> n2; column++){
+            buffer[column * NTT_BLOCK_COLUMNS + row] = source[column];
+        }
+    }
+
+    if(!inverse){
+        ntt_block_dif(buffer, plan -> n2, plan -> row_roots, plan -> prime, kernels);
+    } else {
+        ntt_block_dit(buffer, plan -> n2, plan -> row_inverse_roots, plan -> prime, kernels);
+    }
+
+    for(row = 0; row < NTT_BLOCK_COLUMNS; row++){
+        source = data + (first_row + row) * plan -> n2;
+        for(column = 0; column < plan -> n2; column++){
+            source[column] = buffer[column * NTT_BLOCK_COLUMNS + row];
+        }
+    }
+}
+
+/*
+ * Forward transform of data. The result is stored in a permuted order
+ * that the inverse transform undoes
+ */
+static void ntt_forward(uint32_t * data, const ntt_plan * plan, const ntt_kernels * kernels){
+    long block;
+
+    #pragma omp parallel
+    {
+        uint32_t * buffer = malloc(plan -> n2 * NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+        #pragma omp for schedule(static)
+        for(block = 0; block < (long) (plan -> n2 / NTT_BLOCK_COLUMNS); block++){
+            ntt_forward_columns(data, buffer, block * NTT_BLOCK_COLUMNS, plan, kernels);
+        }
+
+        #pragma omp for schedule(static)
+        for(block = 0; block < (long) (plan -> n1 / NTT_BLOCK_COLUMNS); block++){
+            ntt_transform_rows(data, buffer, block * NTT_BLOCK_COLUMNS, 0, plan, kernels);
+        }
+        free(buffer);
+    }
+}
+
+/*
+ * Inverse transform of data, scaled by n^-1 2^32
+ */
+static void ntt_inverse(uint32_t * data, const ntt_plan * plan, const ntt_kernels * kernels){
+    long block;
+
+    #pragma omp parallel
+    {
+        uint32_t * buffer = malloc(plan -> n2 * NTT_BLOCK_COLUMNS * sizeof(uint32_t));
+        #pragma omp for schedule(static)
+        for(block = 0; block < (long) (plan -> n1 / NTT_BLOCK_COLUMNS); block++){
+            ntt_transform_rows(data, buffer, block * NTT_BLOCK_COLUMNS, 1, plan, kernels);
+        }
+
+        #pragma omp for schedule(static)
+        for(block = 0; block < (long) (plan -> n2 / NTT_BLOCK_COLUMNS); block++){
+            ntt_inverse_columns(data, buffer, block * NTT_BLOCK_COLUMNS, plan, kernels);
+        }
+        free(buffer);
+    }
+}
+
+
+/************************************************************************************
+ * Multiplication                                                                   *
+ ************************************************************************************/
+
+/*
+ * Stores in data the 32 bit pieces of |x| modulo p, padded with zeros
+ */
+static void ntt_load(uint32_t * data, mpz_srcptr x, size_t n, uint32_t p){
+    size_t pieces = mpz_size(x) * (GMP_NUMB_BITS / 32);
+    long i;
+
+    #pragma omp parallel for schedule(static)
+    for(i = 0; i < (long) n; i++){
+        data[i] = ((size_t) i < pieces) ? (uint32_t) (mpz_getlimbn(x, i / (GMP_NUMB_BITS / 32)) >> (32 * (i % (GMP_NUMB_BITS / 32)))) % p : 0;
+    }
+}
+
+/*
+ * Recovers the coefficients from their residues (Garner) and propagates the
+ * carries. Each chunk is processed by a thread and the carries between chunks
+ * are added at the end
+ */
+static void ntt_garner_and_carry(uint32_t * words, uint32_t ** residues, size_t n){
+    const uint64_t p1 = ntt_primes[0].p, p2 = ntt_primes[1].p, p3 = ntt_primes[2].p;
+    const uint64_t p1_inverse = ntt_pow_mod(p1, p2 - 2, p2);                   // p1^-1 mod p2
+    const uint64_t p1p2_inverse = ntt_pow_mod(p1 * p2 % p3, p3 - 2, p3);       // (p1 p2)^-1 mod p3
+    long chunks = (n + NTT_CARRY_CHUNK - 1) / NTT_CARRY_CHUNK;
+    long chunk;
+    size_t i;
+    uint64_t * carries = malloc(chunks * sizeof(uint64_t));
+    uint64_t carry, sum;
+
+    #pragma omp parallel for schedule(static)
+    for(chunk = 0; chunk < chunks; chunk++){
+        size_t k, end = ((size_t) (chunk + 1) * NTT_CARRY_CHUNK < n) ? (size_t) (chunk + 1) * NTT_CARRY_CHUNK : n;
+        uint64_t v1, v2, v3, t;
+        unsigned __int128 accumulator = 0;
+
+        for(k = (size_t) chunk * NTT_CARRY_CHUNK; k < end; k++){
+            v1 = residues[0][k];
+            v2 = (residues[1][k] + p2 - v1 % p2) % p2 * p1_inverse % p2;
+            t = (v1 + p1 * v2) % p3;
+            v3 = (residues[2][k] + p3 - t) % p3 * p1p2_inverse % p3;
+            accumulator += v1 + p1 * v2 + (unsigned __int128) (p1 * p2) * v3;
+            words[k] = (uint32_t) accumulator;
+            accumulator >>= 32;
+        }
+        //The coefficients are smaller than 2^91, so the carry fits in 64 bits
+        carries[chunk] = (uint64_t) accumulator;
+    }
+
+    for(chunk = 0; chunk < chunks; chunk++){
+        carry = carries[chunk];
+        for(i = (size_t) (chunk + 1) * NTT_CARRY_CHUNK; carry != 0 && i < n; i++){
+            sum = (uint64_t) words[i] + (carry & 0xFFFFFFFF);
+            words[i] = (uint32_t) sum;
+            carry = (carry >> 32) + (sum >> 32);
+        }
+    }
+
+    free(carries);
+}
+
+/*
+ * Bytes of the buffers used by gmp_ntt_mpz_mul (0 if the operands do not
+ * fit in the largest transform)
+ */
+size_t gmp_ntt_scratch_bytes(mp_size_t a_size, mp_size_t b_size){
+    size_t pieces = (a_size + b_size) * (GMP_NUMB_BITS / 32);
+    int log_n;
+
+    for(log_n = NTT_MIN_LOG_SIZE; ((size_t) 1 << log_n) < pieces; log_n++);
+    if(log_n > NTT_MAX_LOG_SIZE) return 0;
+    //The residues, the transform of b and the words of the result (the plan is smaller)
+    return (NTT_PRIMES + 2) * ((size_t) 1 << log_n) * sizeof(uint32_t);
+}
+
+/*
+ * r = a * b using the number theoretic transform. Operands whose product
+ * does not fit in the largest transform are multiplied with mpz_mul
+ */
+void gmp_ntt_mpz_mul(mpz_t r, mpz_srcptr a, mpz_srcptr b){
+    size_t pieces, n;
+    int log_n, i, negative, square;
+    uint32_t * residues[NTT_PRIMES], * b_data, * words;
+    ntt_plan plan;
+    ntt_kernels kernels;
+    mpz_t result;
+
+    if(mpz_sgn(a) == 0 || mpz_sgn(b) == 0){
+        mpz_set_ui(r, 0);
+        return;
+    }
+    pieces = (mpz_size(a) + mpz_size(b)) * (GMP_NUMB_BITS / 32);
+    for(log_n = NTT_MIN_LOG_SIZE; ((size_t) 1 << log_n) < pieces; log_n++);
+    if(log_n > NTT_MAX_LOG_SIZE){
+        mpz_mul(r, a, b);
+        return;
+    }
+    n = (size_t) 1 << log_n;
+
+    ntt_init_primes();
+    kernels = ntt_select_kernels();
+    negative = (mpz_sgn(a) < 0) != (mpz_sgn(b) < 0);
+    square = (a == b) || (mpz_size(a) == mpz_size(b) && mpz_cmpabs(a, b) == 0);
+
+    b_data = (square) ? NULL : malloc(n * sizeof(uint32_t));
+    for(i = 0; i < NTT_PRIMES; i++){
+        ntt_init_plan(&plan, log_n, &ntt_primes[i]);
+        residues[i] = malloc(n * sizeof(uint32_t));
+
+        ntt_load(residues[i], a, n, ntt_primes[i].p);
+        ntt_forward(residues[i], &plan, &kernels);
+        if(square){
+            kernels.mul(residues[i], residues[i], residues[i], 0, n, &ntt_primes[i]);
+        } else {
+            ntt_load(b_data, b, n, ntt_primes[i].p);
+            ntt_forward(b_data, &plan, &kernels);
+            kernels.mul(residues[i], residues[i], b_data, 0, n, &ntt_primes[i]);
+        }
+        ntt_inverse(residues[i], &plan, &kernels);
+
+        ntt_clear_plan(&plan);
+    }
+    free(b_data);
+
+    words = malloc(n * sizeof(uint32_t));
+    ntt_garner_and_carry(words, residues, n);
+    for(i = 0; i < NTT_PRIMES; i++) free(residues[i]);
+
+    mpz_init(result);
+    mpz_import(result, n, -1, sizeof(uint32_t), 0, 0, words);
+    if(negative) mpz_neg(result, result);
+    mpz_swap(r, result);
+
+    mpz_clear(result);
+    free(words);
+}
@@ -0,0 +1,7 @@
+#ifndef GMP_NTT_MULTIPLICATION
+#define GMP_NTT_MULTIPLICATION
+
+void gmp_ntt_mpz_mul(mpz_t, mpz_srcptr, mpz_srcptr);
+size_t gmp_ntt_scratch_bytes(mp_size_t, mp_size_t);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gmp.h>
+#include <omp.h>
+#include "ntt_multiplication.h"
+
+
+#define PARALLEL_MUL_THRESHOLD 4096     // Limbs of the smallest operand
+#define PARALLEL_NTT_THRESHOLD 1048576  // From here the threaded NTT beats the Karatsuba split
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Parallel multiplication of big operands                                          *
+ * It is used for the products that are performed by a single thread (outside the   *
+ * parallel regions of the algorithms), like the Newton final division              *
+ *                                                                                  *
+ ************************************************************************************
+ * The top levels of the product are split with Karatsuba and each subproduct is    *
+ * an OpenMP task. Below the split depth (or the threshold) mpz_mul is used:        *
+ *                                                                                  *
+ *      a = a1 B^m + a0,   b = b1 B^m + b0                                          *
+ *                                                                                  *
+ *      z0 = a0 b0,   z2 = a1 b1,   z1 = (a0 + a1) (b0 + b1) - z0 - z2              *
+ *                                                                                  *
+ *      a b = z2 B^2m + z1 B^m + z0                                                 *
+ *                                                                                  *
+ * When a is, at least, twice as large as b only a is split, so both halves are     *
+ * multiplied by b without extra work:  a b = (a1 b) B^m + a0 b                     *
+ *                                                                                  *
+ * The depth is chosen so that there are, at least, as many leaves as threads.      *
+ * Huge operands are multiplied with the number theoretic transform instead, which  *
+ * splits all the work among the threads (gmp_ntt_mpz_mul).                         *
+ * Inside a parallel region the rest of the threads are busy, so mpz_mul is used.   *
+ *                                                                                  *
+ * With a memory limit (set by the planner) the NTT is only used if its buffers     *
+ * fit, and the split depth is lowered until the temporaries of the Karatsuba       *
+ * levels (about 2 (a + b) limbs per level) fit                                     *
+ *                                                                                  *
+ ************************************************************************************/
+
+static unsigned long parallel_mul_memory_limit = 0;    // Bytes for temporaries (0: no limit)
+
+/*
+ * Sets the bytes that the temporaries of a parallel product may use
+ */
+void gmp_parallel_mul_set_memory_limit(unsigned long bytes){
+    parallel_mul_memory_limit = bytes;
+}
+
+static int gmp_parallel_mul_fits(unsigned long bytes){
+    return parallel_mul_memory_limit == 0 || bytes <= parallel_mul_memory_limit;
+}
+
+/*
+ * Stores in view the limbs [from, from + size) of the absolute value of x
+ */
+mpz_srcptr gmp_limbs_view(mpz_t view, mpz_srcptr x, mp_size_t from, mp_size_t size){
+    return mpz_roinit_n(view, x -> _mp_d + from, size);
+}
+
+/*
+ * Karatsuba split of r = |a| * |b| with tasks, |a| >= |b|
+ */
+void gmp_parallel_mul_recursive(mpz_t r, mpz_srcptr a, mpz_srcptr b, int depth){
+    mp_size_t a_size, b_size, m;
+    mpz_t a0, a1, b0, b1, z0, z1, z2, a_sum, b_sum;
+    mpz_srcptr swap;
+
+    if(mpz_size(a) < mpz_size(b)){
+        swap = a; a = b; b = swap;
+    }
+    a_size = mpz_size(a);
+    b_size = mpz_size(b);
+
+    if(depth == 0 || b_size < PARALLEL_MUL_THRESHOLD){
+        mpz_mul(r, a, b);
+        mpz_abs(r, r);
+        return;
+    }
+
+    mpz_inits(z0, z2, NULL);
+    if(a_size >= 2 * b_size){
+        //Unbalanced: a = a1 B^m + a0
+        m = a_size / 2;
+        gmp_limbs_view(a0, a, 0, m);
+        gmp_limbs_view(a1, a, m, a_size - m);
+
+        #pragma omp task shared(z0, a0, b)
+        gmp_parallel_mul_recursive(z0, a0, b, depth - 1);
+        #pragma omp task shared(z2, a1, b)
+        gmp_parallel_mul_recursive(z2, a1, b, depth - 1);
+        #pragma omp taskwait
+
+        mpz_mul_2exp(z2, z2, m * GMP_NUMB_BITS);
+        mpz_add(r, z2, z0);
+        mpz_clears(z0, z2, NULL);
+        return;
+    }
+
+    //Balanced: Karatsuba
+    m = a_size / 2;
+    mpz_inits(z1, a_sum, b_sum, NULL);
+    gmp_limbs_view(a0, a, 0, m);
+    gmp_limbs_view(a1, a, m, a_size - m);
+    mpz_add(a_sum, a0, a1);
+    if(a == b){
+        #pragma omp task shared(z0, a0)
+        gmp_parallel_mul_recursive(z0, a0, a0, depth - 1);
+        #pragma omp task shared(z2, a1)
+        gmp_parallel_mul_recursive(z2, a1, a1, depth - 1);
+        #pragma omp task shared(z1, a_sum)
+        gmp_parallel_mul_recursive(z1, a_sum, a_sum, depth - 1);
+        #pragma omp taskwait
+    } else {
+        gmp_limbs_view(b0, b, 0, m);
+        gmp_limbs_view(b1, b, m, b_size - m);
+        mpz_add(b_sum, b0, b1);
+        #pragma omp task shared(z0, a0, b0)
+        gmp_parallel_mul_recursive(z0, a0, b0, depth - 1);
+        #pragma omp task shared(z2, a1, b1)
+        gmp_parallel_mul_recursive(z2, a1, b1, depth - 1);
+        #pragma omp task shared(z1, a_sum, b_sum)
+        gmp_parallel_mul_recursive(z1, a_sum, b_sum, depth - 1);
+        #pragma omp taskwait
+    }
+
+    // z1 = (a0 + a1) (b0 + b1) - z0 - z2
+    mpz_sub(z1, z1, z0);
+    mpz_sub(z1, z1, z2);
+
+    // r = z2 B^2m + z1 B^m + z0
+    mpz_mul_2exp(z2, z2, m * GMP_NUMB_BITS);
+    mpz_add(z2, z2, z1);
+    mpz_mul_2exp(z2, z2, m * GMP_NUMB_BITS);
+    mpz_add(r, z2, z0);
+
+    mpz_clears(z0, z1, z2, a_sum, b_sum, NULL);
+}
+
+/*
+ * r = a * b using all the threads available when the operands are big enough
+ */
+void gmp_parallel_mpz_mul(mpz_t r, mpz_srcptr a, mpz_srcptr b){
+    int depth, num_threads, negative;
+    mpz_t a_abs, b_abs, result;
+    mpz_srcptr b_view;
+
+    num_threads = omp_get_max_threads();
+    if(omp_in_parallel() || num_threads < 2 || mpz_size(a) < PARALLEL_MUL_THRESHOLD || mpz_size(b) < PARALLEL_MUL_THRESHOLD){
+        mpz_mul(r, a, b);
+        return;
+    }
+
+    if(mpz_size(a) >= PARALLEL_NTT_THRESHOLD && mpz_size(b) >= PARALLEL_NTT_THRESHOLD
+       && gmp_parallel_mul_fits(gmp_ntt_scratch_bytes(mpz_size(a), mpz_size(b)))){
+        gmp_ntt_mpz_mul(r, a, b);
+        return;
+    }
+
+    //Leaves = 3^depth >= num_threads
+    depth = (int) ceil(log(num_threads) / log(3));
+    while(depth > 0 && !gmp_parallel_mul_fits(2UL * depth * (mpz_size(a) + mpz_size(b)) * sizeof(mp_limb_t))) depth--;
+    if(depth == 0){
+        mpz_mul(r, a, b);
+        return;
+    }
+    negative = (mpz_sgn(a) < 0) != (mpz_sgn(b) < 0);
+    mpz_roinit_n(a_abs, a -> _mp_d, mpz_size(a));
+    b_view = (a == b) ? a_abs : mpz_roinit_n(b_abs, b -> _mp_d, mpz_size(b));
+    mpz_init(result);
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        #pragma omp single
+        gmp_parallel_mul_recursive(result, a_abs, b_view, depth);
+    }
+
+    if(negative) mpz_neg(result, result);
+    mpz_swap(r, result);
+    mpz_clear(result);
+}
+
+/*
+ * r = a * b (mpf version). The mantissas are multiplied with gmp_parallel_mpz_mul,
+ * only with the limbs that mpf_mul would use
+ */
+void gmp_parallel_mpf_mul(mpf_t r, mpf_t a, mpf_t b){
+    mp_size_t a_size, b_size, prec_limbs;
+    mp_exp_t exponent;
+    mpz_t a_mantissa, b_mantissa, product;
+
+    a_size = abs(a -> _mp_size);
+    b_size = abs(b -> _mp_size);
+    prec_limbs = r -> _mp_prec + 1;
+    if(a_size > prec_limbs) a_size = prec_limbs;
+    if(b_size > prec_limbs) b_size = prec_limbs;
+
+    if(omp_in_parallel() || omp_get_max_threads() < 2 || a_size < PARALLEL_MUL_THRESHOLD || b_size < PARALLEL_MUL_THRESHOLD){
+        mpf_mul(r, a, b);
+        return;
+    }
+
+    mpz_roinit_n(a_mantissa, a -> _mp_d + abs(a -> _mp_size) - a_size, (a -> _mp_size < 0) ? -a_size : a_size);
+    mpz_roinit_n(b_mantissa, b -> _mp_d + abs(b -> _mp_size) - b_size, (b -> _mp_size < 0) ? -b_size : b_size);
+    mpz_init(product);
+    gmp_parallel_mpz_mul(product, a_mantissa, (a == b) ? a_mantissa : b_mantissa);
+
+    //Value of the product = product * B^(exponent - size(product))
+    exponent = a -> _mp_exp + b -> _mp_exp - (a_size + b_size);
+    mpf_set_z(r, product);
+    r -> _mp_exp += exponent;
+
+    mpz_clear(product);
+}
@@ -0,0 +1,8 @@
+#ifndef GMP_PARALLEL_MULTIPLICATION
+#define GMP_PARALLEL_MULTIPLICATION
+
+void gmp_parallel_mpz_mul(mpz_t, mpz_srcptr, mpz_srcptr);
+void gmp_parallel_mpf_mul(mpf_t, mpf_t, mpf_t);
+void gmp_parallel_mul_set_memory_limit(unsigned long);
+
+#endif
@@ -4,7 +4,18 @@
 #include <time.h>
 #include <stdbool.h>
 #include "../common/printer.h"
+#include "../common/memory_planner.h"
+#include "../common/iterations.h"
+#include "../common/output.h"
+#include "../common/packed.h"
+#include "../common/hex_verification.h"
+#include "../common/hex_output.h"
+#include "../common/checkpoint.h"
+#include "../common/bench.h"
+#include "../common/phase_timers.h"
+#include "parallel_multiplication.h"
 #include "check_decimals.h"
+#include "radix_conversion.h"
 #include "algorithms/bbp_blocks.h"
 #include "algorithms/bbp_cyclic.h"
 #include "algorithms/bellard_bit_shift_power_cyclic.h"
@@ -14,19 +25,151 @@
 #include "algorithms/chudnovsky_simplified_expression_snake_like.h"
 #include "algorithms/chudnovsky_simplified_expression_integers_blocks.h"
 #include "algorithms/chudnovsky_craig_wood_expression.h"
+#include "algorithms/chudnovsky_simplified_expression_cyclic.h"
 
 
 double gettimeofday();
 
 
-void gmp_calculate_pi(int algorithm, int precision, int num_threads, bool print_in_csv_format){
-    int num_iterations, decimals_computed, precision_bits;
-    double execution_time;
+/*
+ * Refuses the execution if its estimated memory does not fit in the limit
+ * and leaves the rest of the budget to the parallel multiplications
+ */
+void gmp_plan_memory(char * algorithm_tag, unsigned long estimate){
+    memory_planner_check(algorithm_tag, estimate);
+    gmp_parallel_mul_set_memory_limit(memory_planner_scratch(estimate));
+}
+
+/*
+ * Converts pi to decimal and writes its first decimals in the output file (-o)
+ */
+void gmp_write_pi(mpf_t pi, long decimals, int num_threads, bool print_in_csv_format){
+    double output_time;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    gmp_radix_write(pi, decimals, num_threads);
+    gettimeofday(&t2, NULL);
+
+    output_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_output_stats_csv(output_get_path(), decimals, output_time, output_get_write_time());
+    } else {
+        print_output_stats(output_get_path(), decimals, output_time, output_get_write_time());
+    }
+}
+
+/*
+ * Converts pi to decimal and packs its first decimals in the packed file (-packed)
+ */
+void gmp_pack_pi(mpf_t pi, char * algorithm_tag, long decimals, int num_threads, bool print_in_csv_format){
+    double packed_time;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    gmp_radix_pack(pi, algorithm_tag, decimals, num_threads);
+    gettimeofday(&t2, NULL);
+
+    packed_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_packed_stats_csv(packed_get_path(), decimals, packed_time, packed_get_bytes());
+    } else {
+        print_packed_stats(packed_get_path(), decimals, packed_time, packed_get_bytes());
+    }
+}
+
+/*
+ * Verifies pi without reference with the BBP hex digit extraction (-verify-hex)
+ */
+void gmp_verify_pi(mpf_t pi, long precision, int num_threads, bool print_in_csv_format){
+    double verification_time;
+    long verified_decimals;
+    int matches;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    verified_decimals = gmp_check_hex_digits(pi, precision, num_threads, &matches);
+    gettimeofday(&t2, NULL);
+
+    verification_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_hex_verification_stats_csv(verified_decimals, matches, HEX_VERIFICATION_POSITIONS, verification_time);
+    } else {
+        print_hex_verification_stats(verified_decimals, matches, HEX_VERIFICATION_POSITIONS, verification_time);
+    }
+}
+
+/*
+ * Mantissa of pi for common/hex_output.c (the limbs of the mpf, read in place: the integer part of pi takes the top limb)
+ */
+void gmp_hex_mantissa(mpf_t pi, hex_mantissa * mantissa){
+    mantissa -> limbs = (const uint64_t *) pi -> _mp_d;
+    mantissa -> num_limbs = pi -> _mp_size;
+    mantissa -> integer_bits = 64 * pi -> _mp_exp;
+}
+
+/*
+ * Writes the hex digits of pi from its limbs, without radix conversion (-hex)
+ */
+void gmp_write_hex_pi(mpf_t pi, long precision, int num_threads, bool print_in_csv_format){
+    double output_time;
+    long digits;
+    hex_mantissa mantissa;
     struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    gmp_hex_mantissa(pi, &mantissa);
+    digits = hex_output_write(&mantissa, hex_output_digits(precision), num_threads);
+    gettimeofday(&t2, NULL);
+
+    output_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    if (print_in_csv_format) {
+        print_hex_output_stats_csv(hex_output_get_path(), digits, output_time);
+    } else {
+        print_hex_output_stats(hex_output_get_path(), digits, output_time);
+    }
+}
+
+/*
+ * Returns the correct hex digits of pi against the hex reference, without radix
+ * conversion (-hex-check), and the time of the check in check_time
+ */
+long gmp_check_hex_pi(mpf_t pi, int num_threads, double * check_time){
+    long correct_digits;
+    hex_mantissa mantissa;
+    struct timeval t1, t2;
+
+    gettimeofday(&t1, NULL);
+    gmp_hex_mantissa(pi, &mantissa);
+    correct_digits = hex_output_check(&mantissa, num_threads);
+    gettimeofday(&t2, NULL);
+
+    *check_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
+    return correct_digits;
+}
+
+/*
+ * True if the engine writes checkpoints (the block engines)
+ */
+bool gmp_checkpoints_supported(int algorithm){
+    return algorithm == 1 || algorithm == 5 || algorithm == 7;
+}
+
+void gmp_calculate_pi(int algorithm, long precision, int num_threads, bool print_in_csv_format){
+    long num_iterations, decimals_computed, precision_bits, correct_hex_digits;
+    int num_checkpoints;
+    unsigned long estimate;
+    double execution_start, execution_time, hex_check_time;
     char *algorithm_tag;
     mpf_t pi;
 
-    gettimeofday(&t1, NULL);
+    if (checkpoint_is_enabled() && !gmp_checkpoints_supported(algorithm)) {
+        printf("  Checkpoints are only written by the block engines (GMP 1, 5 and 7). \n\n");
+        exit(-1);
+    }
+
+    phase_timers_begin();
+    execution_start = bench_clock();
 
     //Set gmp float precision (in bits) and init pi
     precision_bits = precision * 8;
@@ -36,83 +179,139 @@ void gmp_calculate_pi(int algorithm, int precision, int num_threads, bool print_
     switch (algorithm)
     {
     case 0:
-        num_iterations = precision * 0.84;
+        num_iterations = iterations_bbp(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-BBP-CYC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 7, 2));
         gmp_bbp_cyclic_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 1:
-        num_iterations = precision * 0.84;
+        num_iterations = iterations_bbp(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-BBP-BLC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 7, 1));
+        checkpoint_begin(algorithm_tag, precision, num_iterations, num_threads);
         gmp_bbp_blocks_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 2:
-        num_iterations = precision / 3;
+        num_iterations = iterations_bellard(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-BEL-BSP-CYC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 10, 1));
         gmp_bellard_bit_shift_power_cyclic_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 3:
-        num_iterations = precision / 3;
+        num_iterations = iterations_bellard(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-BEL-RCP-CYC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 10, 1));
         gmp_bellard_recursive_power_cyclic_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 4:
-        num_iterations = (precision + 14 - 1) / 14;  
+        num_iterations = iterations_chudnovsky(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-CHD-CAF-BLC";
-        gmp_chudnovsky_all_factorials_blocks_algorithm(pi, num_iterations, num_threads);
+        estimate = memory_planner_estimate(precision_bits, num_threads, 9, 2);
+        num_checkpoints = gmp_chudnovsky_factorial_checkpoints(num_iterations, num_threads, memory_planner_scratch(estimate));
+        gmp_plan_memory(algorithm_tag, estimate + gmp_chudnovsky_factorial_checkpoints_bytes(num_iterations, num_checkpoints));
+        gmp_chudnovsky_all_factorials_blocks_algorithm(pi, num_iterations, num_threads, num_checkpoints);
         break;
 
     case 5:
-        num_iterations = (precision + 14 - 1) / 14;  
+        num_iterations = iterations_chudnovsky(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-CHD-SME-BLC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 11, 2));
+        checkpoint_begin(algorithm_tag, precision, num_iterations, num_threads);
         gmp_chudnovsky_simplified_expression_blocks_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 6:
-        num_iterations = (precision + 14 - 1) / 14;  
+        num_iterations = iterations_chudnovsky(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-CHD-SME-SNK";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 11, 2));
         gmp_chudnovsky_simplified_expression_snake_like_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 7:
-        num_iterations = (precision + 14 - 1) / 14;  
+        num_iterations = iterations_chudnovsky(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-CHD-SME-INT-BLC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 16, 2));
+        checkpoint_begin(algorithm_tag, precision, num_iterations, num_threads);
         gmp_chudnovsky_simplified_expression_integers_blocks_algorithm(pi, num_iterations, num_threads);
         break;
 
     case 8:
-        num_iterations = (precision + 14 - 1) / 14;  
+        num_iterations = iterations_chudnovsky(precision);
         check_errors(precision, num_iterations, num_threads);
         algorithm_tag = "GMP-CHD-CWE-SEQ";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 0, 9));
         gmp_chudnovsky_craig_wood_expression_algorithm(pi, num_iterations, num_threads);
         break;
 
+    case 9:
+        num_iterations = iterations_chudnovsky(precision);
+        check_errors(precision, num_iterations, num_threads);
+        algorithm_tag = "GMP-CHD-SME-CYC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 9, 3));
+        gmp_chudnovsky_simplified_expression_cyclic_algorithm(pi, num_iterations, num_threads);
+        break;
+
+    case 10:
+        num_iterations = iterations_chudnovsky(precision);
+        check_errors(precision, num_iterations, num_threads);
+        algorithm_tag = "GMP-CHD-SME-BLC-CYC";
+        gmp_plan_memory(algorithm_tag, memory_planner_estimate(precision_bits, num_threads, 9, 3));
+        gmp_chudnovsky_simplified_expression_block_cyclic_algorithm(pi, num_iterations, num_threads);
+        break;
+
     default:
         printf("  Algorithm number selected not availabe, try with another number. \n");
         printf("\n");
         exit(-1);
         break;
     }
+    checkpoint_end();
 
-    gettimeofday(&t2, NULL);
-    execution_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6; 
-    decimals_computed = gmp_check_decimals(pi);
-    if (print_in_csv_format) {
+    execution_time = bench_clock() - execution_start;
+    if (hex_check_is_enabled()) {
+        correct_hex_digits = gmp_check_hex_pi(pi, num_threads, &hex_check_time);
+        decimals_computed = hex_output_decimals(correct_hex_digits);
+    } else {
+        decimals_computed = gmp_check_decimals(pi, num_threads);
+    }
+    if (bench_is_running()) {
+        bench_record(algorithm_tag, execution_time, decimals_computed);
+    } else if (print_in_csv_format) {
         print_results_csv("GMP", algorithm_tag, precision, num_iterations, num_threads, decimals_computed, execution_time);
     } else {
         print_results("GMP", algorithm_tag, precision, num_iterations, num_threads, decimals_computed, execution_time);
     }
+    if (hex_check_is_enabled()) {
+        if (print_in_csv_format) {
+            print_hex_check_stats_csv(correct_hex_digits, hex_reference_digits(), hex_check_time);
+        } else {
+            print_hex_check_stats(correct_hex_digits, hex_reference_digits(), hex_check_time);
+        }
+    }
+    if (hex_verification_is_enabled()) {
+        gmp_verify_pi(pi, precision, num_threads, print_in_csv_format);
+    }
+    if (output_is_enabled()) {
+        gmp_write_pi(pi, precision, num_threads, print_in_csv_format);
+    }
+    if (packed_is_enabled()) {
+        gmp_pack_pi(pi, algorithm_tag, precision, num_threads, print_in_csv_format);
+    }
+    if (hex_output_is_enabled()) {
+        gmp_write_hex_pi(pi, precision, num_threads, print_in_csv_format);
+    }
 
     // gmp_printf("%.Ff \n", pi);
     mpf_clear(pi);
@@ -1,6 +1,6 @@
 #ifndef GMP_PI_CALCULATOR
 #define GMP_PI_CALCULATOR
 
-void gmp_calculate_pi(int, int, int, bool);
+void gmp_calculate_pi(int, long, int, bool);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gmp.h>
+#include <omp.h>
+#include "../common/memory_allocator.h"
+#include "../common/numa.h"
+#include "../common/output.h"
+#include "../common/verification.h"
+#include "../common/packed.h"
+#include "parallel_multiplication.h"
+
+
+#define RADIX_LEAF_DIGITS 1024          // Digits of each leaf (converted with mpz_get_str)
+#define RADIX_GUARD_BITS 64             // Extra bits of each node against the truncations
+#define RADIX_CHUNK_LEVEL 10            // Chunks of 1024 2^10 decimals are converted and written at once
+#define RADIX_LOG2_10 3.321928094887362
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Binary to decimal conversion of the fractional part of pi                        *
+ *                                                                                  *
+ ************************************************************************************
+ * The conversion is a scaled remainder tree: the digits are taken from the binary  *
+ * fraction f (0 <= f < 1) of pi with products only (no divisions). A node of the   *
+ * tree owns L = 2h digits of a fraction f, kept as a fixed point integer y of B    *
+ * bits (f ~ y / 2^B), and splits them:                                             *
+ *                                                                                  *
+ *      first h digits:  f                      (y >> (B - B'))                     *
+ *      last h digits:   frac(f 10^h)           ((y 10^h mod 2^B) >> (B - B'))      *
+ *                                                                                  *
+ * being B' = h log2(10) + 64 the bits of the children. The leaves (1024 digits)    *
+ * take floor(f 10^1024) with mpz_get_str. The powers 10^(1024 2^i) are computed    *
+ * once. The truncations only lose a few units of 2^-64 of a leaf, so a digit could *
+ * only be wrong next to a run of about 18 nines or zeros.                          *
+ *                                                                                  *
+ * The top levels are split one by one with the parallel multiplication (there are  *
+ * less nodes than threads) and the rest of the nodes are converted in parallel.    *
+ * The nodes that only have digits beyond the requested ones are not computed.      *
+ *                                                                                  *
+ * The decimal string is not built as a whole: each thread converts the subtrees of *
+ * its nodes chunk by chunk (about 1M decimals, the subtrees of level 10) in order, *
+ * and hands each chunk to a consumer while the other threads keep converting: the  *
+ * output file (common/output.c) writes it at its offset, the packed file           *
+ * (common/packed.c) packs it in words of 19 decimals and the verification          *
+ * (common/verification.c) compares it with the reference. Each thread only needs   *
+ * a chunk of memory                                                                *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Bits of the fixed point fraction of a node with digits digits
+ */
+unsigned long gmp_radix_bits(long digits){
+    return (unsigned long) ceil(digits * RADIX_LOG2_10) + RADIX_GUARD_BITS;
+}
+
+/*
+ * Splits the fraction y (bits bits) of a node of level level in the fractions
+ * of its children (top and bottom), with the parallel multiplication when
+ * it is called outside the parallel region
+ */
+void gmp_radix_split(mpz_t top, mpz_t bottom, mpz_t y, int level, mpz_t * powers){
+    unsigned long bits = gmp_radix_bits((long) RADIX_LEAF_DIGITS << level);
+    unsigned long child_bits = gmp_radix_bits((long) RADIX_LEAF_DIGITS << (level - 1));
+
+    gmp_parallel_mpz_mul(bottom, y, powers[level - 1]);
+    mpz_tdiv_r_2exp(bottom, bottom, bits);
+    mpz_tdiv_q_2exp(bottom, bottom, bits - child_bits);
+    mpz_tdiv_q_2exp(top, y, bits - child_bits);
+}
+
+/*
+ * Writes in digits the decimals [offset, offset + 1024 2^level) of the fraction y,
+ * without going further than decimals. The fraction is destroyed
+ */
+void gmp_radix_convert(char * digits, long offset, long decimals, mpz_t y, int level, mpz_t * powers){
+    char leaf[RADIX_LEAF_DIGITS + 2];
+    size_t length;
+    long half;
+    mpz_t bottom;
+
+    if(offset >= decimals) return;
+
+    if(level == 0){
+        mpz_mul(y, y, powers[0]);
+        mpz_tdiv_q_2exp(y, y, gmp_radix_bits(RADIX_LEAF_DIGITS));
+        mpz_get_str(leaf, 10, y);
+        //Leading zeros of the leaf
+        length = strlen(leaf);
+        memset(digits + offset, '0', RADIX_LEAF_DIGITS - length);
+        memcpy(digits + offset + RADIX_LEAF_DIGITS - length, leaf, length);
+        return;
+    }
+
+    half = (long) RADIX_LEAF_DIGITS << (level - 1);
+    if(offset + half >= decimals){
+        //Only the first half is needed
+        mpz_tdiv_q_2exp(y, y, gmp_radix_bits(half << 1) - gmp_radix_bits(half));
+        gmp_radix_convert(digits, offset, decimals, y, level - 1, powers);
+        return;
+    }
+    mpz_init(bottom);
+    gmp_radix_split(y, bottom, y, level, powers);
+    gmp_radix_convert(digits, offset, decimals, y, level - 1, powers);
+    gmp_radix_convert(digits, offset + half, decimals, bottom, level - 1, powers);
+    mpz_clear(bottom);
+}
+
+/*
+ * Converts the decimals [offset, offset + 1024 2^level) of the fraction y (without going
+ * further than decimals) and writes them chunk by chunk (1024 2^chunk_level decimals)
+ * through buffer to consume. The fraction is destroyed
+ */
+void gmp_radix_write_node(mpz_t y, long offset, long decimals, int level, int chunk_level, mpz_t * powers, char * buffer,
+                          void (*consume)(long, char *, long)){
+    long half, length;
+    mpz_t bottom;
+
+    if(offset >= decimals) return;
+
+    if(level == chunk_level){
+        length = (long) RADIX_LEAF_DIGITS << level;
+        if(length > decimals - offset) length = decimals - offset;
+        gmp_radix_convert(buffer, 0, length, y, level, powers);
+        consume(offset, buffer, length);
+        return;
+    }
+
+    half = (long) RADIX_LEAF_DIGITS << (level - 1);
+    if(offset + half >= decimals){
+        //Only the first half is needed
+        mpz_tdiv_q_2exp(y, y, gmp_radix_bits(half << 1) - gmp_radix_bits(half));
+        gmp_radix_write_node(y, offset, decimals, level - 1, chunk_level, powers, buffer, consume);
+        return;
+    }
+    mpz_init(bottom);
+    gmp_radix_split(y, bottom, y, level, powers);
+    gmp_radix_write_node(y, offset, decimals, level - 1, chunk_level, powers, buffer, consume);
+    gmp_radix_write_node(bottom, offset + half, decimals, level - 1, chunk_level, powers, buffer, consume);
+    mpz_clear(bottom);
+}
+
+/*
+ * Levels of the tree of decimals digits
+ */
+int gmp_radix_levels(long decimals){
+    int levels = 0;
+
+    while(((long) RADIX_LEAF_DIGITS << levels) < decimals) levels++;
+    return levels;
+}
+
+/*
+ * Bits of the fraction that gmp_radix_convert_fraction needs for decimals digits
+ */
+unsigned long gmp_radix_fraction_bits(long decimals){
+    return gmp_radix_bits((long) RADIX_LEAF_DIGITS << gmp_radix_levels(decimals));
+}
+
+/*
+ * Converts the first decimals digits of the fraction (fraction / 2^gmp_radix_fraction_bits)
+ * and hands them to consume chunk by chunk, in any order. It uses num_threads threads
+ */
+void gmp_radix_convert_fraction(mpz_t fraction, long decimals, int num_threads, void (*consume)(long, char *, long)){
+    int levels, level, chunk_level, num_powers, num_nodes, next_num_nodes, j;
+    long node_digits;
+
+    levels = gmp_radix_levels(decimals);
+
+    //Chunks of up to 1024 2^10 decimals, and at least two per thread if there are enough decimals
+    chunk_level = (RADIX_CHUNK_LEVEL < levels) ? RADIX_CHUNK_LEVEL : levels;
+    while(chunk_level > 0 && ((long) RADIX_LEAF_DIGITS << chunk_level) * 2 * num_threads > decimals) chunk_level--;
+
+    //powers[i] = 10^(1024 2^i), for the leaves and the splits of the levels 1 ... levels
+    num_powers = (levels > 0) ? levels : 1;
+    mpz_t powers[num_powers];
+    mpz_init(powers[0]);
+    mpz_ui_pow_ui(powers[0], 10, RADIX_LEAF_DIGITS);
+    for(j = 1; j < num_powers; j++){
+        mpz_init(powers[j]);
+        gmp_parallel_mpz_mul(powers[j], powers[j - 1], powers[j - 1]);
+    }
+
+    //Top levels: one node after another with the parallel multiplication
+    mpz_t nodes[num_threads * 2];
+    long offsets[num_threads * 2];
+    mpz_init_set(nodes[0], fraction);
+    offsets[0] = 0;
+    num_nodes = 1;
+    for(level = levels; level > chunk_level && num_nodes < num_threads; level--){
+        node_digits = (long) RADIX_LEAF_DIGITS << (level - 1);
+        next_num_nodes = num_nodes;
+        for(j = 0; j < num_nodes; j++){
+            //The first half stays in node j and the second one (if it is needed) is appended
+            offsets[next_num_nodes] = offsets[j] + node_digits;
+            if(offsets[next_num_nodes] < decimals){
+                mpz_init(nodes[next_num_nodes]);
+                gmp_radix_split(nodes[j], nodes[next_num_nodes], nodes[j], level, powers);
+                next_num_nodes++;
+            } else {
+                mpz_tdiv_q_2exp(nodes[j], nodes[j], gmp_radix_bits(node_digits << 1) - gmp_radix_bits(node_digits));
+            }
+        }
+        num_nodes = next_num_nodes;
+    }
+
+    //Rest of the tree: each thread converts its nodes and consumes their chunks while the others convert
+    omp_set_num_threads(num_threads);
+
+    #pragma omp parallel
+    {
+        int thread_id = omp_get_thread_num();
+        char * buffer;
+
+        numa_bind_thread(thread_id, num_threads);
+        buffer = malloc((size_t) RADIX_LEAF_DIGITS << chunk_level);
+        if(buffer == NULL){
+            printf("Not enough memory to convert the decimals \n");
+            exit(-1);
+        }
+
+        #pragma omp for schedule(dynamic)
+        for(j = 0; j < num_nodes; j++){
+            gmp_radix_write_node(nodes[j], offsets[j], decimals, level, chunk_level, powers, buffer, consume);
+            mpz_clear(nodes[j]);
+        }
+        free(buffer);
+        memory_allocator_release_thread();
+    }
+
+    for(j = 0; j < num_powers; j++){
+        mpz_clear(powers[j]);
+    }
+}
+
+/*
+ * Takes the fraction of pi for decimals decimals (fraction = floor(frac(pi) 2^gmp_radix_fraction_bits))
+ * and returns the integer part
+ */
+unsigned long gmp_radix_fraction(mpz_t fraction, mpf_t pi, long decimals){
+    unsigned long integer_part;
+    mpf_t float_fraction;
+
+    mpf_init2(float_fraction, mpf_get_prec(pi));
+    mpf_floor(float_fraction, pi);
+    integer_part = mpf_get_ui(float_fraction);
+    mpf_sub(float_fraction, pi, float_fraction);
+    mpf_mul_2exp(float_fraction, float_fraction, gmp_radix_fraction_bits(decimals));
+    mpz_set_f(fraction, float_fraction);
+    mpf_clear(float_fraction);
+    return integer_part;
+}
+
+/*
+ * Writes integer_part and the first decimals digits of the fraction in the output file
+ */
+void gmp_radix_write_fraction(unsigned long integer_part, mpz_t fraction, long decimals, int num_threads){
+    output_write_header(integer_part);
+    gmp_radix_convert_fraction(fraction, decimals, num_threads, output_write_digits);
+    output_close(decimals);
+}
+
+/*
+ * Packs integer_part and the first decimals digits of the fraction in the packed file
+ */
+void gmp_radix_pack_fraction(char * algorithm_tag, long precision, unsigned long integer_part, mpz_t fraction, long decimals, int num_threads){
+    packed_begin(algorithm_tag, precision, integer_part, decimals);
+    gmp_radix_convert_fraction(fraction, decimals, num_threads, packed_write_digits);
+    packed_end(num_threads);
+}
+
+/*
+ * Compares integer_part and the first decimals digits of the fraction with the reference
+ * and returns the number of correct decimals
+ */
+long gmp_radix_verify_fraction(unsigned long integer_part, mpz_t fraction, long decimals, int num_threads){
+    verification_begin(integer_part, decimals);
+    gmp_radix_convert_fraction(fraction, decimals, num_threads, verification_check_chunk);
+    return verification_end();
+}
+
+/*
+ * Writes pi with decimals decimals in the output file. It uses num_threads threads
+ */
+void gmp_radix_write(mpf_t pi, long decimals, int num_threads){
+    unsigned long integer_part;
+    mpz_t fraction;
+
+    mpz_init(fraction);
+    integer_part = gmp_radix_fraction(fraction, pi, decimals);
+    gmp_radix_write_fraction(integer_part, fraction, decimals, num_threads);
+    mpz_clear(fraction);
+}
+
+/*
+ * Packs pi with decimals decimals in the packed file. It uses num_threads threads
+ */
+void gmp_radix_pack(mpf_t pi, char * algorithm_tag, long decimals, int num_threads){
+    unsigned long integer_part;
+    mpz_t fraction;
+
+    mpz_init(fraction);
+    integer_part = gmp_radix_fraction(fraction, pi, decimals);
+    gmp_radix_pack_fraction(algorithm_tag, decimals, integer_part, fraction, decimals, num_threads);
+    mpz_clear(fraction);
+}
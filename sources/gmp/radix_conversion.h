@@ -0,0 +1,13 @@
+#ifndef GMP_RADIX_CONVERSION
+#define GMP_RADIX_CONVERSION
+
+unsigned long gmp_radix_fraction_bits(long);
+unsigned long gmp_radix_fraction(mpz_t, mpf_t, long);
+void gmp_radix_convert_fraction(mpz_t, long, int, void (*)(long, char *, long));
+void gmp_radix_write_fraction(unsigned long, mpz_t, long, int);
+void gmp_radix_pack_fraction(char *, long, unsigned long, mpz_t, long, int);
+long gmp_radix_verify_fraction(unsigned long, mpz_t, long, int);
+void gmp_radix_write(mpf_t, long, int);
+void gmp_radix_pack(mpf_t, char *, long, int);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef GMP_REDUCTION
+#define GMP_REDUCTION
+
+void gmp_tree_reduction(mpf_t, mpf_t, mpf_ptr *, int, int);
+
+#endif
@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "spill.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Spill of GMP integers (mpz_t) to the scratch file                                *
+ *                                                                                  *
+ ************************************************************************************
+ * Only the limbs are written. The variable is cleared and initialized again, so    *
+ * it stays valid (and small) while its value is on disk. When it is reloaded it    *
+ * takes back its size                                                              *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Spills z if it is big enough. Returns 1 if it has been spilled
+ */
+int gmp_spill_mpz(gmp_spilled_value * spilled, mpz_t z){
+    size_t bytes = mpz_size(z) * sizeof(mp_limb_t);
+
+    spilled -> spilled = spill_worth(bytes);
+    if(!spilled -> spilled) return 0;
+
+    spilled -> size = z -> _mp_size;
+    spill_store(&spilled -> slot, mpz_limbs_read(z), bytes);
+    mpz_clear(z);
+    mpz_init(z);
+    return 1;
+}
+
+/*
+ * Loads the value of a spilled mpz_t in z
+ */
+void gmp_reload_mpz(mpz_t z, gmp_spilled_value * spilled){
+    mp_size_t size = abs(spilled -> size);
+
+    spill_load(&spilled -> slot, mpz_limbs_write(z, size));
+    mpz_limbs_finish(z, spilled -> size);
+    spill_release(&spilled -> slot);
+    spilled -> spilled = 0;
+}
+
+/*
+ * The spilled value will be reloaded soon
+ */
+void gmp_prefetch_spilled(gmp_spilled_value * spilled){
+    if(spilled -> spilled) spill_prefetch(&spilled -> slot);
+}
@@ -0,0 +1,16 @@
+#ifndef GMP_SPILL
+#define GMP_SPILL
+
+#include "../common/spill.h"
+
+typedef struct {
+    spill_slot slot;
+    int spilled;
+    int size;
+} gmp_spilled_value;
+
+int gmp_spill_mpz(gmp_spilled_value *, mpz_t);
+void gmp_reload_mpz(mpz_t, gmp_spilled_value *);
+void gmp_prefetch_spilled(gmp_spilled_value *);
+
+#endif
@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <gmp.h>
+#include <sys/time.h>
+#include "../common/printer.h"
+#include "../common/verification.h"
+#include "streaming.h"
+
+
+#define STREAM_FIRST_BATCH 8            // Terms of the first batch (the first decimals come out at once)
+#define STREAM_MAX_BATCH 8192           // Terms of the biggest batch (about 2466 decimals)
+#define STREAM_MAX_LATENCIES 24
+#define LOG10_2 0.30102999566398120
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Unbounded streaming spigot (Gibbons) with the decimals flushed as they become    *
+ * final (-stream)                                                                  *
+ *                                                                                  *
+ ************************************************************************************
+ * pi is the composition of the linear fractional transformations:                  *
+ *                                                                                  *
+ *               k x + 4k + 2                                                       *
+ *      T_k(x) = ------------,  k >= 1,   pi = T_1(T_2(T_3(...)))                   *
+ *                  2k + 1                                                          *
+ *                                                                                  *
+ * The state is the composition of the terms absorbed, S(x) = (q x + r) / t, and    *
+ * the rest of the terms always give an x between 3 and 4, so pi is between S(3)    *
+ * and S(4). The decimals where S(3) and S(4) agree are final: they are emitted     *
+ * and taken out of the state (d is the number they form):                          *
+ *                                                                                  *
+ *      S(x) = 10^e (S(x) - d)   ->   q = 10^e q,  r = 10^e r - d t                 *
+ *                                                                                  *
+ * Instead of a term at a time, the terms are absorbed in batches (their product    *
+ * is computed by binary splitting) and the common decimals of S(3) and S(4) are    *
+ * extracted at once. The batches start with 8 terms, so the first decimals come    *
+ * out at once, and they double up to 8192 terms for throughput. No precision is    *
+ * fixed in advance: the stream goes on while decimals are requested.               *
+ *                                                                                  *
+ * The decimals are flushed to the output (stdout or a file) after each batch and   *
+ * checked against the reference. The time to the first and to the 10^j-th decimal  *
+ * is reported (a latency oriented workload, next to the throughput oriented        *
+ * engines)                                                                         *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * q, r, t = (q, r, t) o (q2, r2, t2)
+ */
+static void gmp_stream_compose(mpz_t q, mpz_t r, mpz_t t, mpz_t q2, mpz_t r2, mpz_t t2){
+    mpz_mul(r, r, t2);
+    mpz_addmul(r, q, r2);
+    mpz_mul(q, q, q2);
+    mpz_mul(t, t, t2);
+}
+
+/*
+ * q, r, t = T_a o T_a+1 o ... o T_b-1 (binary splitting)
+ */
+static void gmp_stream_product(mpz_t q, mpz_t r, mpz_t t, long a, long b){
+    mpz_t q2, r2, t2;
+    long middle;
+
+    if(b - a == 1){
+        mpz_set_ui(q, a);
+        mpz_set_ui(r, 4 * a + 2);
+        mpz_set_ui(t, 2 * a + 1);
+        return;
+    }
+    middle = (a + b) / 2;
+    mpz_inits(q2, r2, t2, NULL);
+    gmp_stream_product(q, r, t, a, middle);
+    gmp_stream_product(q2, r2, t2, middle, b);
+    gmp_stream_compose(q, r, t, q2, r2, t2);
+    mpz_clears(q2, r2, t2, NULL);
+}
+
+/*
+ * bound = floor(power (x q + r) / t), written in text with length digits (zeros on the left)
+ */
+static void gmp_stream_bound(mpz_t bound, char * text, long length, mpz_t q, mpz_t r, mpz_t t, unsigned long x, mpz_t power){
+    long digits;
+
+    mpz_mul_ui(bound, q, x);
+    mpz_add(bound, bound, r);
+    mpz_mul(bound, bound, power);
+    mpz_tdiv_q(bound, bound, t);
+    mpz_get_str(text, 10, bound);
+    digits = strlen(text);
+    if(digits < length){
+        memmove(text + length - digits, text, digits + 1);
+        memset(text, '0', length - digits);
+    }
+}
+
+/*
+ * Streams the integer part and the first decimals decimals of pi to path (stdout if
+ * it is NULL) and prints the latencies
+ */
+void gmp_stream_pi(long decimals, char * path, bool print_in_csv_format){
+    FILE * output = stdout;
+    mpz_t q, r, t, q_batch, r_batch, t_batch, low, high, power;
+    char * low_text = NULL, * high_text = NULL;
+    long k = 1, batch = STREAM_FIRST_BATCH, emitted = 0, checked, digits, length, common, new_decimals, capacity = 0;
+    long positions[STREAM_MAX_LATENCIES], next_position = 1, correct_decimals;
+    double latencies[STREAM_MAX_LATENCIES], total_time;
+    int num_latencies = 0;
+    bool integer_pending = true;
+    struct timeval t1, t2;
+
+    if(path != NULL){
+        output = fopen(path, "w");
+        if(output == NULL){
+            printf("  The output file %s can not be created \n\n", path);
+            exit(-1);
+        }
+    }
+    checked = (decimals < verification_reference_decimals()) ? decimals : verification_reference_decimals();
+
+    gettimeofday(&t1, NULL);
+    mpz_init_set_ui(q, 1);
+    mpz_init_set_ui(r, 0);
+    mpz_init_set_ui(t, 1);
+    mpz_inits(q_batch, r_batch, t_batch, low, high, power, NULL);
+
+    while(emitted < decimals){
+        //Absorb the next batch of terms
+        gmp_stream_product(q_batch, r_batch, t_batch, k, k + batch);
+        gmp_stream_compose(q, r, t, q_batch, r_batch, t_batch);
+        k += batch;
+        if(batch < STREAM_MAX_BATCH) batch *= 2;
+
+        //Decimals that S(3) and S(4) may share: the width of the interval is q / t
+        digits = (long) ((double) ((long) mpz_sizeinbase(t, 2) - (long) mpz_sizeinbase(q, 2) - 1) * LOG10_2);
+        if(digits > decimals - emitted) digits = decimals - emitted;
+        if(digits < 1) continue;
+
+        length = digits + (integer_pending ? 1 : 0);
+        if(length + 3 > capacity){
+            capacity = 2 * (length + 3);
+            low_text = realloc(low_text, capacity);
+            high_text = realloc(high_text, capacity);
+            if(low_text == NULL || high_text == NULL){
+                printf("Not enough memory to stream the decimals \n");
+                exit(-1);
+            }
+        }
+        mpz_ui_pow_ui(power, 10, digits);
+        gmp_stream_bound(low, low_text, length, q, r, t, 3, power);
+        gmp_stream_bound(high, high_text, length, q, r, t, 4, power);
+        common = verification_first_mismatch(low_text, high_text, length);
+        if(common == 0) continue;
+
+        //Emit the final digits
+        if(integer_pending){
+            fprintf(output, "%c.", low_text[0]);
+            verification_begin(low_text[0] - '0', checked);
+        }
+        new_decimals = common - (integer_pending ? 1 : 0);
+        fwrite(low_text + (integer_pending ? 1 : 0), 1, new_decimals, output);
+        fflush(output);
+        if(emitted < checked){
+            verification_check_chunk(emitted, low_text + (integer_pending ? 1 : 0), (emitted + new_decimals < checked) ? new_decimals : checked - emitted);
+        }
+
+        //Take them out of the state: d = floor(10^new_decimals S(3))
+        mpz_ui_pow_ui(power, 10, digits - new_decimals);
+        mpz_tdiv_q(low, low, power);
+        mpz_ui_pow_ui(power, 10, new_decimals);
+        mpz_mul(q, q, power);
+        mpz_mul(r, r, power);
+        mpz_submul(r, low, t);
+        emitted += new_decimals;
+        integer_pending = false;
+
+        //Latencies of the decimals 1, 10, 100, ...
+        gettimeofday(&t2, NULL);
+        while(num_latencies < STREAM_MAX_LATENCIES - 1 && next_position <= emitted){
+            positions[num_latencies] = next_position;
+            latencies[num_latencies++] = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6;
+            next_position *= 10;
+        }
+    }
+    //Latency of the last decimal
+    if(positions[num_latencies - 1] != decimals){
+        positions[num_latencies] = decimals;
+        latencies[num_latencies++] = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6;
+    }
+    fprintf(output, "\n");
+    gettimeofday(&t2, NULL);
+    total_time = ((t2.tv_sec - t1.tv_sec) * 1000000u +  t2.tv_usec - t1.tv_usec)/1.e6;
+    if(path != NULL) fclose(output);
+    else printf("\n");
+    correct_decimals = verification_end();
+
+    if (print_in_csv_format) {
+        print_stream_stats_csv(decimals, correct_decimals, k - 1, total_time, positions, latencies, num_latencies);
+    } else {
+        print_stream_stats(decimals, correct_decimals, k - 1, total_time, positions, latencies, num_latencies);
+    }
+
+    mpz_clears(q, r, t, q_batch, r_batch, t_batch, low, high, power, NULL);
+    free(low_text);
+    free(high_text);
+}
@@ -0,0 +1,6 @@
+#ifndef GMP_STREAMING
+#define GMP_STREAMING
+
+void gmp_stream_pi(long, char *, bool);
+
+#endif
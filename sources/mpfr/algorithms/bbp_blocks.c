@@ -2,6 +2,13 @@
 #include <stdlib.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../checkpoint.h"
+#include "../exponent_range.h"
 
 
 #define QUOTIENT 0.0625
@@ -39,14 +46,14 @@
 /*
  * An iteration of Bailey Borwein Plouffe formula
  */
-void mpfr_bbp_iteration(mpfr_t pi, int n, mpfr_t dep_m, mpfr_t quot_a, mpfr_t quot_b, mpfr_t quot_c, mpfr_t quot_d, mpfr_t aux){
+void mpfr_bbp_iteration(mpfr_t pi, long n, mpfr_t dep_m, mpfr_t quot_a, mpfr_t quot_b, mpfr_t quot_c, mpfr_t quot_d, mpfr_t aux){
     mpfr_set_ui(quot_a, 4, MPFR_RNDN);              // quot_a = ( 4 / (8n + 1))
     mpfr_set_ui(quot_b, 2, MPFR_RNDN);              // quot_b = (-2 / (8n + 4))
     mpfr_set_ui(quot_c, 1, MPFR_RNDN);              // quot_c = (-1 / (8n + 5))
     mpfr_set_ui(quot_d, 1, MPFR_RNDN);              // quot_d = (-1 / (8n + 6))
     mpfr_set_ui(aux, 0, MPFR_RNDN);                 // aux = a + b + c + d  
 
-    int i = n << 3;                     // i = 8n
+    unsigned long i = n << 3;           // i = 8n
     mpfr_div_ui(quot_a, quot_a, i | 1, MPFR_RNDN);  // 4 / (8n + 1)
     mpfr_div_ui(quot_b, quot_b, i | 4, MPFR_RNDN);  // 2 / (8n + 4)
     mpfr_div_ui(quot_c, quot_c, i | 5, MPFR_RNDN);  // 1 / (8n + 5)
@@ -64,44 +71,58 @@ void mpfr_bbp_iteration(mpfr_t pi, int n, mpfr_t dep_m, mpfr_t quot_a, mpfr_t qu
 }
 
 
-void mpfr_bbp_blocks_algorithm(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+void mpfr_bbp_blocks_algorithm(mpfr_t pi, long num_iterations, int num_threads, long precision_bits){
     mpfr_t quotient; 
 
     mpfr_init_set_d(quotient, QUOTIENT, MPFR_RNDN);         // quotient = (1 / 16)   
 
+    mpfr_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, block_size, block_start, block_end;
+        int thread_id;
+        long i, block_start, block_end;
         mpfr_t local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        mpfr_exponent_range_widen();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
         
         mpfr_inits2(precision_bits, local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);
-        mpfr_set_ui(local_pi, 0, MPFR_RNDN);
-        mpfr_pow_ui(dep_m, quotient, block_start, MPFR_RNDN);    // m = (1/16)^n                  
+        mpfr_ptr state[] = {local_pi, dep_m};
+
+        //With -resume the thread goes on from its checkpoint
+        if(!mpfr_checkpoint_load(thread_id, &block_start, state, 2)){
+            mpfr_set_ui(local_pi, 0, MPFR_RNDN);
+            mpfr_pow_ui(dep_m, quotient, block_start, MPFR_RNDN);    // m = (1/16)^n                  
+        }
+
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
 
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             mpfr_bbp_iteration(local_pi, i, dep_m, quot_a, quot_b, quot_c, quot_d, aux);
             // Update dependencies:  
             mpfr_mul(dep_m, dep_m, quotient, MPFR_RNDN);
+
+            //Checkpoint of the state before the iteration i + 1 (written by another thread)
+            if(checkpoint_due(thread_id)) mpfr_checkpoint_save(thread_id, i + 1, state, 2);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+        mpfr_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_pi, dep_m, quot_a, quot_b, quot_c, quot_d, aux, NULL);   
+        memory_allocator_release_thread();
     }
         
     //Clear memory
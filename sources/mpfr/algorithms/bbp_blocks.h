@@ -1,6 +1,7 @@
 #ifndef MPFR_BBP_BLOCKS
 #define MPFR_BBP_BLOCKS
 
-void mpfr_bbp_blocks_algorithm(mpfr_t, int, int, int);
+void mpfr_bbp_blocks_algorithm(mpfr_t, long, int, long);
+void mpfr_bbp_iteration(mpfr_t, long, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t);
 
 #endif
@@ -3,6 +3,11 @@
 #include <mpfr.h>
 #include <omp.h>
 #include "bellard_recursive_power_cyclic.h"
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../exponent_range.h"
 
 
 /************************************************************************************
@@ -39,19 +44,25 @@
  ************************************************************************************/
 
 
-void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t pi, long num_iterations, int num_threads, long precision_bits){
     mpfr_t ONE; 
     mpfr_init_set_ui(ONE, 1, MPFR_RNDN); 
 
+    mpfr_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b, next_i;
+        int thread_id;
+        long i, dep_a, dep_b, jump_dep_a, jump_dep_b, next_i;
         mpfr_t local_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        mpfr_exponent_range_widen();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
         mpfr_inits2(precision_bits, local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);
         mpfr_set_ui(local_pi, 0, MPFR_RNDN);
         dep_a = thread_id * 4;
@@ -62,6 +73,8 @@ void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t pi, int num_iterations
         mpfr_pow_si(dep_m, dep_m, -1, MPFR_RNDN);
         if(thread_id % 2 != 0) mpfr_neg(dep_m, dep_m, MPFR_RNDN);                   
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable
         for(i = thread_id; i < num_iterations; i+=num_threads){
             mpfr_bellard_iteration(local_pi, i, dep_m, a, b, c, d, e, f, g, aux, dep_a, dep_b);
@@ -73,14 +86,15 @@ void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t pi, int num_iterations
             dep_a += jump_dep_a;
             dep_b += jump_dep_b;  
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+        mpfr_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
     mpfr_div_2exp(pi, pi, 6, MPFR_RNDN); // pi = pi / 2⁶
@@ -1,6 +1,6 @@
 #ifndef MPFR_BELLARD_BIT_SHIFT_POWER_CYCLIC
 #define MPFR_BELLARD_BIT_SHIFT_POWER_CYCLIC
 
-void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t, int, int, int);
+void mpfr_bellard_bit_shift_power_cyclic_algorithm(mpfr_t, long, int, long);
 
 #endif
@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../exponent_range.h"
 
 
 
@@ -41,8 +46,8 @@
 /*
  * An iteration of Bellard formula
  */
-void mpfr_bellard_iteration(mpfr_t pi, int n, mpfr_t m, mpfr_t a, mpfr_t b, mpfr_t c, mpfr_t d, 
-                    mpfr_t e, mpfr_t f, mpfr_t g, mpfr_t aux, int dep_a, int dep_b){
+void mpfr_bellard_iteration(mpfr_t pi, long n, mpfr_t m, mpfr_t a, mpfr_t b, mpfr_t c, mpfr_t d, 
+                    mpfr_t e, mpfr_t f, mpfr_t g, mpfr_t aux, long dep_a, long dep_b){
     mpfr_set_ui(a, 32, MPFR_RNDN);              // a = ( 32 / ( 4n + 1))
     mpfr_set_ui(b, 1, MPFR_RNDN);               // b = (  1 / ( 4n + 3))
     mpfr_set_ui(c, 256, MPFR_RNDN);             // c = (256 / (10n + 1))
@@ -77,22 +82,28 @@ void mpfr_bellard_iteration(mpfr_t pi, int n, mpfr_t m, mpfr_t a, mpfr_t b, mpfr
 }
 
 
-void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t pi, long num_iterations, int num_threads, long precision_bits){
     mpfr_t jump; 
 
     mpfr_init_set_ui(jump, 1, MPFR_RNDN);
     mpfr_div_ui(jump, jump, 1024, MPFR_RNDN);
     mpfr_pow_ui(jump, jump, num_threads, MPFR_RNDN);
 
+    mpfr_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {
-        int thread_id, i, dep_a, dep_b, jump_dep_a, jump_dep_b;
+        int thread_id;
+        long i, dep_a, dep_b, jump_dep_a, jump_dep_b;
         mpfr_t local_pi, dep_m, a, b, c, d, e, f, g, aux;
 
         thread_id = omp_get_thread_num();
+        mpfr_exponent_range_widen();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
         mpfr_inits2(precision_bits, local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);
         mpfr_set_ui(local_pi, 0, MPFR_RNDN);               // private thread pi
         dep_a = thread_id * 4;
@@ -104,6 +115,8 @@ void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t pi, int num_iterations
         mpfr_pow_ui(dep_m, dep_m, thread_id, MPFR_RNDN);        // dep_m = ((-1)^n)/1024)
         if(thread_id % 2 != 0) mpfr_neg(dep_m, dep_m, MPFR_RNDN);                   
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable
         if(num_threads % 2 != 0){
             for(i = thread_id; i < num_iterations; i+=num_threads){
@@ -123,14 +136,15 @@ void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t pi, int num_iterations
                 dep_b += jump_dep_b;  
             }
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+        mpfr_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
 
         //Clear thread memory
         mpfr_free_cache();
         mpfr_clears(local_pi, dep_m, a, b, c, d, e, f, g, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
     mpfr_div_ui(pi, pi, 64, MPFR_RNDN);
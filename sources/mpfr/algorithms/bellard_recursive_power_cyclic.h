@@ -1,7 +1,7 @@
 #ifndef MPFR_BELLARD_RECURSIVE_POWER_CYCLIC
 #define MPFR_BELLARD_RECURSIVE_POWER_CYCLIC
 
-void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t, int, int, int);
-void mpfr_bellard_iteration(mpfr_t, int, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, int, int);
+void mpfr_bellard_recursive_power_cyclic_algorithm(mpfr_t, long, int, long);
+void mpfr_bellard_iteration(mpfr_t, long, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, mpfr_t, long, long);
 
 #endif
@@ -3,6 +3,10 @@
 #include <gmp.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "chudnovsky_simplified_expression_blocks.h"
+#include "../newton.h"
+#include "../../common/phase_timers.h"
+#include "../exponent_range.h"
 
 
 #define A 13591409
@@ -28,7 +32,7 @@
 /*
  * An iteration of Chudnovsky formula
  */
-void mpfr_chudnovsky_craig_wood_expression_iteration(int n, mpfr_t sum_a, mpfr_t sum_b, mpfr_t a_n, mpfr_t b_n, mpfr_t a_n_divisor, 
+void mpfr_chudnovsky_craig_wood_expression_iteration(long n, mpfr_t sum_a, mpfr_t sum_b, mpfr_t a_n, mpfr_t b_n, mpfr_t a_n_divisor, 
                                                     mpfr_t factor_a, mpfr_t factor_b, mpfr_t factor_c){
     // Computing a_n
     // factor_a = (6n -5)
@@ -69,27 +73,31 @@ void mpfr_chudnovsky_craig_wood_expression_iteration(int n, mpfr_t sum_a, mpfr_t
 }
 
 
-void mpfr_chudnovsky_craig_wood_expression_algorithm(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
-    int i;
+void mpfr_chudnovsky_craig_wood_expression_algorithm(mpfr_t pi, long num_iterations, int num_threads, long precision_bits){
+    long i;
     mpfr_t sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c;
 
+    //Sequential: only the thread 0 is timed
+    mpfr_exponent_range_widen();
+    phase_timers_start(0);
     mpfr_inits2(precision_bits, sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c, NULL);
     mpfr_set_ui(e, E, MPFR_RNDN);
     mpfr_set_ui(sum_a, 1, MPFR_RNDN);
     mpfr_set_ui(sum_b, 0, MPFR_RNDN);
     mpfr_set_ui(a_n, 1, MPFR_RNDN);
+    phase_timers_lap(0, TIMERS_PHASE_SEED);
     
     for(i = 1; i < num_iterations; i++){
         mpfr_chudnovsky_craig_wood_expression_iteration(i, sum_a, sum_b, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c);
     }
+    phase_timers_lap(0, TIMERS_PHASE_SERIES);
 
     mpfr_mul_ui(sum_a, sum_a, A, MPFR_RNDN);
     mpfr_mul_ui(sum_b, sum_b, B, MPFR_RNDN);
     mpfr_add(pi, sum_a, sum_b, MPFR_RNDN);
     
-    mpfr_sqrt(e, e, MPFR_RNDN);
-    mpfr_mul_ui(e, e, D, MPFR_RNDN);
-    mpfr_div(pi, e, pi, MPFR_RNDN);    
+    mpfr_chudnovsky_constant(e);
+    mpfr_newton_div(pi, e, pi);    
    
     //Clear memory
     mpfr_clears(sum_a, sum_b, e, a_n, b_n, a_n_divisor, factor_a, factor_b, factor_c, NULL);
@@ -1,6 +1,6 @@
 #ifndef MPFR_CHUDNOVSKY_CRAIG_WOOD_EXPRESSION
 #define MPFR_CHUDNOVSKY_CRAIG_WOOD_EXPRESSION
 
-void mpfr_chudnovsky_craig_wood_expression_algorithm(mpfr_t, int, int, int);
+void mpfr_chudnovsky_craig_wood_expression_algorithm(mpfr_t, long, int, long);
 
 #endif
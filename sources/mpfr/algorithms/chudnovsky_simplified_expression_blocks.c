@@ -3,6 +3,14 @@
 #include <gmp.h>
 #include <mpfr.h>
 #include <omp.h>
+#include "../reduction.h"
+#include "../../common/memory_allocator.h"
+#include "../../common/numa.h"
+#include "../../common/phase_timers.h"
+#include "../../common/iterations.h"
+#include "../checkpoint.h"
+#include "../newton.h"
+#include "../exponent_range.h"
 
 
 #define A 13591409
@@ -44,7 +52,7 @@
 /*
  * An iteration of Chudnovsky formula
  */
-void mpfr_chudnovsky_iteration(mpfr_t pi, int n, mpfr_t dep_a, mpfr_t dep_b, 
+void mpfr_chudnovsky_iteration(mpfr_t pi, long n, mpfr_t dep_a, mpfr_t dep_b, 
                             mpfr_t dep_c, mpfr_t aux){
     mpfr_mul(aux, dep_a, dep_c, MPFR_RNDN);
     mpfr_div(aux, aux, dep_b, MPFR_RNDN);
@@ -57,7 +65,7 @@ void mpfr_chudnovsky_iteration(mpfr_t pi, int n, mpfr_t dep_a, mpfr_t dep_b,
  * This method is used by chudnovsky threads
  * for computing the first value of dep_a
  */
-void mpfr_init_dep_a(mpfr_t dep_a, int block_start, int precision_bits){
+void mpfr_init_dep_a(mpfr_t dep_a, long block_start, long precision_bits){
     mpz_t factorial_n, dividend, divisor;
     mpfr_t float_dividend, float_divisor;
     mpz_inits(factorial_n, dividend, divisor, NULL);
@@ -80,38 +88,66 @@ void mpfr_init_dep_a(mpfr_t dep_a, int block_start, int precision_bits){
 }
 
 
-void mpfr_chudnovsky_simplified_expression_blocks_algorithm(mpfr_t pi, int num_iterations, int num_threads, int precision_bits){
+/*
+ * This method computes the constant of the final division: 
+ * e = 426880 sqrt(10005). It is launched as a task while the 
+ * threads are computing the series
+ */
+void mpfr_chudnovsky_constant(mpfr_t e){
+    mpfr_set_ui(e, E, MPFR_RNDN);
+    mpfr_newton_sqrt(e, e);
+    mpfr_mul_ui(e, e, D, MPFR_RNDN);
+}
+
+
+void mpfr_chudnovsky_simplified_expression_blocks_algorithm(mpfr_t pi, long num_iterations, int num_threads, long precision_bits){
     mpfr_t e, c;
 
     mpfr_inits2(precision_bits, e, c, NULL);
-    mpfr_set_ui(e, E, MPFR_RNDN);
     mpfr_set_ui(c, C, MPFR_RNDN);
     mpfr_neg(c, c, MPFR_RNDN);
     mpfr_pow_ui(c, c, 3, MPFR_RNDN);
 
+    mpfr_ptr partials[num_threads];
+
     //Set the number of threads 
     omp_set_num_threads(num_threads);
 
     #pragma omp parallel 
     {   
-        int thread_id, i, block_size, block_start, block_end, factor_a;
+        int thread_id;
+        long i, block_start, block_end, factor_a;
         mpfr_t local_pi, dep_a, dep_a_dividend, dep_a_divisor, dep_b, dep_c, aux;
 
         thread_id = omp_get_thread_num();
-        block_size = (num_iterations + num_threads - 1) / num_threads;
-        block_start = thread_id * block_size;
-        block_end = block_start + block_size;
-        if (block_end > num_iterations) block_end = num_iterations;
+        mpfr_exponent_range_widen();
+        numa_bind_thread(thread_id, num_threads);
+        phase_timers_start(thread_id);
+
+        //The constant of the final division is computed while the series is running
+        #pragma omp single nowait
+        {
+            #pragma omp task
+            mpfr_chudnovsky_constant(e);
+        }
+        iterations_block_bounds(num_iterations, thread_id, num_threads, &block_start, &block_end);
         
         mpfr_inits2(precision_bits, local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);
-        mpfr_set_ui(local_pi, 0, MPFR_RNDN);    // private thread pi
-        mpfr_init_dep_a(dep_a, block_start, precision_bits);
-        mpfr_pow_ui(dep_b, c, block_start, MPFR_RNDN);
-        mpfr_set_ui(dep_c, B, MPFR_RNDN);
-        mpfr_mul_ui(dep_c, dep_c, block_start, MPFR_RNDN);
-        mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
+        mpfr_ptr state[] = {local_pi, dep_a, dep_b, dep_c};
+
+        //With -resume the thread goes on from its checkpoint
+        if(!mpfr_checkpoint_load(thread_id, &block_start, state, 4)){
+            mpfr_set_ui(local_pi, 0, MPFR_RNDN);    // private thread pi
+            mpfr_init_dep_a(dep_a, block_start, precision_bits);
+            mpfr_pow_ui(dep_b, c, block_start, MPFR_RNDN);
+            mpfr_set_ui(dep_c, B, MPFR_RNDN);
+            mpfr_mul_ui(dep_c, dep_c, block_start, MPFR_RNDN);
+            mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
+        }
         factor_a = 12 * block_start;
 
+        phase_timers_lap(thread_id, TIMERS_PHASE_SEED);
+
         //First Phase -> Working on a local variable        
         for(i = block_start; i < block_end; i++){
             mpfr_chudnovsky_iteration(local_pi, i, dep_a, dep_b, dep_c, aux);
@@ -132,19 +168,21 @@ void mpfr_chudnovsky_simplified_expression_blocks_algorithm(mpfr_t pi, int num_i
 
             //Update dep_c:
             mpfr_add_ui(dep_c, dep_c, B, MPFR_RNDN);
+
+            //Checkpoint of the state before the iteration i + 1 (written by another thread)
+            if(checkpoint_due(thread_id)) mpfr_checkpoint_save(thread_id, i + 1, state, 4);
         }
+        phase_timers_lap(thread_id, TIMERS_PHASE_SERIES);
 
         //Second Phase -> Accumulate the result in the global variable 
-        #pragma omp critical
-        mpfr_add(pi, pi, local_pi, MPFR_RNDN);
+        mpfr_tree_reduction(pi, local_pi, partials, thread_id, num_threads);
         
         //Clear thread memory
         mpfr_clears(local_pi, dep_a, dep_b, dep_c, dep_a_dividend, dep_a_divisor, aux, NULL);   
+        memory_allocator_release_thread();
     }
 
-    mpfr_sqrt(e, e, MPFR_RNDN);
-    mpfr_mul_ui(e, e, D, MPFR_RNDN);
-    mpfr_div(pi, e, pi, MPFR_RNDN);    
+    mpfr_newton_div(pi, e, pi);    
     
     //Clear memory
     mpfr_clears(c, e, NULL);
@@ -1,6 +1,9 @@
 #ifndef MPFR_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_BLOCKS
 #define MPFR_CHUDNOVSKY_SIMPLIFIED_EXPRESSION_BLOCKS
 
-void mpfr_chudnovsky_simplified_expression_blocks_algorithm(mpfr_t, int, int, int);
+void mpfr_chudnovsky_simplified_expression_blocks_algorithm(mpfr_t, long, int, long);
+void mpfr_chudnovsky_iteration(mpfr_t, long, mpfr_t, mpfr_t, mpfr_t, mpfr_t);
+void mpfr_init_dep_a(mpfr_t, long, long);
+void mpfr_chudnovsky_constant(mpfr_t);
 
 #endif
@@ -1,35 +1,77 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <stdbool.h>
+#include <gmp.h>
 #include <mpfr.h>
+#include "../common/verification.h"
+#include "../common/hex_verification.h"
+#include "../gmp/radix_conversion.h"
+#include "radix_conversion.h"
 
 
-int mpfr_check_decimals(mpfr_t pi){
-    //Cast the number we want to check to string
-    int bytes_of_pi =  ( (int) ceil((float) pi -> _mpfr_prec / (float) GMP_NUMB_BITS) ) * sizeof(mp_limb_t);
-    char calculated_pi[bytes_of_pi * 8]; 
-    mpfr_sprintf(calculated_pi, "%Re", pi);
-
-    //Read the correct pi number from numeroPiCorrecto.txt file and compares the decimals to calculated pi
-    FILE * file;
-    file = fopen("resources/correct_pi.txt", "r");
-    if(file == NULL){
-        printf("correct_pi.txt not found \n");
-        exit(-1);
-    } 
-
-    char correct_pi_char;
-    int i = 0;
-    while((correct_pi_char = fgetc(file)) != EOF){
-        if( (i >= (bytes_of_pi * 8)) || (correct_pi_char != calculated_pi[i])){
-            break;
+#define LOG10_2 0.30102999566398120
+
+/*
+ * Returns the number of correct decimals of pi. The decimals are converted in
+ * chunks with num_threads threads and compared with the mapped reference
+ * (common/verification.c), so the decimal string of pi is never built
+ */
+long mpfr_check_decimals(mpfr_t pi, int num_threads){
+    //Decimals that the precision of pi can hold, up to the decimals of the reference
+    long decimals = mpfr_get_prec(pi) * LOG10_2, correct_decimals;
+    unsigned long integer_part;
+    mpz_t fraction;
+
+    if(decimals > verification_reference_decimals()) decimals = verification_reference_decimals();
+
+    mpz_init(fraction);
+    integer_part = mpfr_radix_fraction(fraction, pi, decimals);
+    correct_decimals = gmp_radix_verify_fraction(integer_part, fraction, decimals, num_threads);
+    mpz_clear(fraction);
+
+    return correct_decimals;
+}
+
+/*
+ * Hex digits [position + 1, position + 6] of the binary fraction of pi
+ */
+unsigned long mpfr_hex_digits(mpfr_t pi, long position){
+    unsigned long digits;
+    mpfr_t float_fraction;
+    mpz_t fraction;
+
+    mpfr_init2(float_fraction, mpfr_get_prec(pi));
+    mpz_init(fraction);
+    mpfr_frac(float_fraction, pi, MPFR_RNDZ);
+    mpfr_mul_2ui(float_fraction, float_fraction, 4 * (position + HEX_VERIFICATION_DIGITS), MPFR_RNDZ);
+    mpfr_get_z(fraction, float_fraction, MPFR_RNDZ);
+    mpz_tdiv_r_2exp(fraction, fraction, 4 * HEX_VERIFICATION_DIGITS);
+    digits = mpz_get_ui(fraction);
+    mpfr_clear(float_fraction);
+    mpz_clear(fraction);
+    return digits;
+}
+
+/*
+ * Verifies pi without reference: the hex digits of its binary fraction at some positions near
+ * the end are compared with the BBP digit extraction. Returns the decimals verified (the ones
+ * before the last position that matches, if every position before it matches too) and the
+ * number of positions that match in matches
+ */
+long mpfr_check_hex_digits(mpfr_t pi, long precision, int num_threads, int * matches){
+    long positions[HEX_VERIFICATION_POSITIONS], verified_decimals = 0;
+    int num_positions, i;
+    bool all_match = true;
+
+    num_positions = hex_verification_positions(precision, positions);
+    *matches = 0;
+    for(i = 0; i < num_positions; i++){
+        if(hex_verification_match(hex_verification_bbp_digits(positions[i], num_threads), mpfr_hex_digits(pi, positions[i]))){
+            (*matches)++;
+            if(all_match) verified_decimals = hex_verification_decimals(positions[i]);
+        } else {
+            all_match = false;
         }
-        i++;
     }
-    i = (i < 2) ? 0: i - 2;
-    
-    fclose(file);
-
-    //mpfr_printf("Pi: %Re \n", pi);
-    return i;
-}
\ No newline at end of file
+    return verified_decimals;
+}
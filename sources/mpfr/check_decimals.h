@@ -1,7 +1,8 @@
 #ifndef MPFR_CHECK_DECIMALS
 #define MPFR_CHECK_DECIMALS
 
-int mpfr_check_decimals(mpfr_t);
+long mpfr_check_decimals(mpfr_t, int);
+long mpfr_check_hex_digits(mpfr_t, long, int, int *);
 
 #endif
 
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "checkpoint.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Checkpoints of the MPFR values of a thread (common/checkpoint.c). Each value is  *
+ * stored raw: precision, sign and exponent followed by the limbs                   *
+ *                                                                                  *
+ ************************************************************************************/
+
+#define MPFR_CHECKPOINT_HEADER (sizeof(mpfr_prec_t) + sizeof(mpfr_sign_t) + sizeof(mpfr_exp_t))
+
+static size_t mpfr_checkpoint_limbs(mpfr_prec_t precision){
+    return (precision + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+}
+
+/*
+ * Copies the values of thread_id (state before the iteration index) and hands them to
+ * the checkpoint writer. It does nothing if the previous checkpoint of the thread is
+ * still being written
+ */
+void mpfr_checkpoint_save(int thread_id, long index, mpfr_ptr * values, int num_values){
+    size_t bytes = 0, limbs;
+    char * buffer, * cursor;
+    int i;
+
+    for(i = 0; i < num_values; i++){
+        bytes += MPFR_CHECKPOINT_HEADER + mpfr_checkpoint_limbs(values[i] -> _mpfr_prec) * sizeof(mp_limb_t);
+    }
+    buffer = checkpoint_buffer(thread_id, bytes);
+    if(buffer == NULL) return;
+
+    cursor = buffer;
+    for(i = 0; i < num_values; i++){
+        limbs = mpfr_checkpoint_limbs(values[i] -> _mpfr_prec);
+        memcpy(cursor, &values[i] -> _mpfr_prec, sizeof(mpfr_prec_t));
+        memcpy(cursor + sizeof(mpfr_prec_t), &values[i] -> _mpfr_sign, sizeof(mpfr_sign_t));
+        memcpy(cursor + sizeof(mpfr_prec_t) + sizeof(mpfr_sign_t), &values[i] -> _mpfr_exp, sizeof(mpfr_exp_t));
+        cursor += MPFR_CHECKPOINT_HEADER;
+        memcpy(cursor, values[i] -> _mpfr_d, limbs * sizeof(mp_limb_t));
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    checkpoint_submit(thread_id, index, bytes);
+}
+
+/*
+ * Restores the values of thread_id from its checkpoint (-resume). Returns 1 and the
+ * next iteration in index, or 0 if the thread has no checkpoint
+ */
+int mpfr_checkpoint_load(int thread_id, long * index, mpfr_ptr * values, int num_values){
+    size_t bytes, limbs;
+    char * buffer, * cursor;
+    mpfr_prec_t precision;
+    int i;
+
+    buffer = checkpoint_load(thread_id, index, &bytes);
+    if(buffer == NULL) return 0;
+
+    cursor = buffer;
+    for(i = 0; i < num_values; i++){
+        limbs = mpfr_checkpoint_limbs(values[i] -> _mpfr_prec);
+        if(cursor + MPFR_CHECKPOINT_HEADER + limbs * sizeof(mp_limb_t) > buffer + bytes) precision = 0;
+        else memcpy(&precision, cursor, sizeof(mpfr_prec_t));
+        if(precision != values[i] -> _mpfr_prec){
+            printf("  The checkpoint of the thread %d does not match the execution \n\n", thread_id);
+            exit(-1);
+        }
+        memcpy(&values[i] -> _mpfr_sign, cursor + sizeof(mpfr_prec_t), sizeof(mpfr_sign_t));
+        memcpy(&values[i] -> _mpfr_exp, cursor + sizeof(mpfr_prec_t) + sizeof(mpfr_sign_t), sizeof(mpfr_exp_t));
+        cursor += MPFR_CHECKPOINT_HEADER;
+        memcpy(values[i] -> _mpfr_d, cursor, limbs * sizeof(mp_limb_t));
+        cursor += limbs * sizeof(mp_limb_t);
+    }
+    free(buffer);
+    return 1;
+}
@@ -0,0 +1,9 @@
+#ifndef MPFR_CHECKPOINT
+#define MPFR_CHECKPOINT
+
+#include "../common/checkpoint.h"
+
+void mpfr_checkpoint_save(int, long, mpfr_ptr *, int);
+int mpfr_checkpoint_load(int, long *, mpfr_ptr *, int);
+
+#endif
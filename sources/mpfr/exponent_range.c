@@ -0,0 +1,27 @@
+#include <mpfr.h>
+#include "exponent_range.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Exponent range of MPFR for billions of digits                                    *
+ *                                                                                  *
+ ************************************************************************************
+ * The default exponent range of MPFR is [1 - 2^30, 2^30 - 1] bits. The terms of    *
+ * the series go much further than that: (1/16)^n of BBP is out of range from       *
+ * n = 2^28 (320 million digits) and (-640320)^3n of Chudnovsky from 18 million     *
+ * iterations (260 million digits), so they underflow to 0 or overflow to inf and   *
+ * the result is wrong without any error.                                           *
+ *                                                                                  *
+ * The range is a property of each thread (MPFR is built thread safe), so every     *
+ * thread that computes terms widens it to the biggest one before its first term    *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Widens the exponent range of the calling thread to the biggest one of MPFR
+ */
+void mpfr_exponent_range_widen(){
+    mpfr_set_emin(mpfr_get_emin_min());
+    mpfr_set_emax(mpfr_get_emax_max());
+}
@@ -0,0 +1,6 @@
+#ifndef MPFR_EXPONENT_RANGE
+#define MPFR_EXPONENT_RANGE
+
+void mpfr_exponent_range_widen();
+
+#endif
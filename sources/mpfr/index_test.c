@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../common/index_test.h"
+#include "../common/iterations.h"
+#include "algorithms/bbp_blocks.h"
+#include "algorithms/bellard_recursive_power_cyclic.h"
+#include "algorithms/chudnovsky_simplified_expression_blocks.h"
+#include "exponent_range.h"
+#include "index_test.h"
+
+
+#define QUOTIENT 0.0625
+#define A 13591409
+#define B 545140134
+#define C 640320
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Index test of the engines of MPFR (see common/index_test.c)                      *
+ *                                                                                  *
+ ************************************************************************************
+ * The functions of the engines are called at the biggest indices of the execution  *
+ * with INDEX_TEST_PRECISION_BITS, and their dependencies are seeded as the         *
+ * engines seed them:                                                               *
+ *                                                                                  *
+ *      BBP:            dep_m = (1/16)^n, term n - 1                                *
+ *      Bellard:        dep_m = (-1)^n / 1024^n and 2^10n, term n - 1               *
+ *      Chudnovsky:     dep_a, dep_b and dep_c at the last block, term n - 1        *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Checks a value of the index test
+ */
+static int mpfr_index_test_check(char * name, long n, mpfr_t value, long double expected_log2, int expected_sign){
+    double mantissa;
+    long exponent;
+
+    mantissa = mpfr_get_d_2exp(&exponent, value, MPFR_RNDN);
+    return index_test_check(name, n, mantissa, exponent, expected_log2, expected_sign);
+}
+
+/*
+ * Index test of MPFR: calls the functions of the engines at the last terms
+ * of num_bbp, num_bellard and num_chudnovsky iterations with num_threads threads
+ */
+int mpfr_index_test(long num_bbp, long num_bellard, long num_chudnovsky, int num_threads){
+    long n, seed, block_start, block_end;
+    mpfr_t term, quotient, dep_m, dep_a, dep_b, dep_c, c, a, b, d, e, f, g, h, aux;
+    long double expected_log2;
+    int ok = 1, sign;
+
+    //As the threads of the engines
+    mpfr_exponent_range_widen();
+    mpfr_inits2(INDEX_TEST_PRECISION_BITS, term, quotient, dep_m, dep_a, dep_b, dep_c, c, a, b, d, e, f, g, h, aux, NULL);
+
+    //BBP: last term, with the seed of the blocks (no terms with the smallest precisions)
+    if (num_bbp > 0) {
+        n = num_bbp - 1;
+        mpfr_set_d(quotient, QUOTIENT, MPFR_RNDN);
+        mpfr_pow_ui(dep_m, quotient, n, MPFR_RNDN);
+        mpfr_set_ui(term, 0, MPFR_RNDN);
+        mpfr_bbp_iteration(term, n, dep_m, a, b, d, e, aux);
+        ok &= mpfr_index_test_check("MPFR BBP term (n)", n, term, index_test_log2_bbp_term(n), 1);
+    }
+
+    //Bellard: last term, with the seeds of the recursive power and the bit shift power
+    if (num_bellard > 0) {
+        n = num_bellard - 1;
+        mpfr_set_ui(dep_m, 1, MPFR_RNDN);
+        mpfr_div_ui(dep_m, dep_m, 1024, MPFR_RNDN);
+        mpfr_pow_ui(dep_m, dep_m, n, MPFR_RNDN);
+        if(n % 2 != 0) mpfr_neg(dep_m, dep_m, MPFR_RNDN);
+        mpfr_set_ui(term, 0, MPFR_RNDN);
+        mpfr_bellard_iteration(term, n, dep_m, a, b, d, e, f, g, h, aux, 4 * n, 10 * n);
+        expected_log2 = index_test_log2_bellard_term(n, &sign);
+        ok &= mpfr_index_test_check("MPFR Bellard term (n)", n, term, expected_log2, sign);
+        mpfr_set_ui(aux, 1, MPFR_RNDN);
+        mpfr_mul_2exp(dep_m, aux, 10 * n, MPFR_RNDN);
+        ok &= mpfr_index_test_check("MPFR Bellard shift 2^10n (n)", n, dep_m, 10.0L * n, 1);
+    }
+
+    //Chudnovsky: seeds of the last block
+    mpfr_set_ui(c, C, MPFR_RNDN);
+    mpfr_neg(c, c, MPFR_RNDN);
+    mpfr_pow_ui(c, c, 3, MPFR_RNDN);
+    iterations_block_bounds(num_chudnovsky, num_threads - 1, num_threads, &block_start, &block_end);
+    seed = (block_start < INDEX_TEST_SEED_MAX) ? block_start : INDEX_TEST_SEED_MAX;
+    mpfr_init_dep_a(dep_a, seed, INDEX_TEST_PRECISION_BITS);
+    ok &= mpfr_index_test_check("MPFR Chudnovsky seed dep_a (n)", seed, dep_a, index_test_log2_dep_a(seed), 1);
+    mpfr_pow_ui(dep_b, c, block_start, MPFR_RNDN);
+    ok &= mpfr_index_test_check("MPFR Chudnovsky seed dep_b (n)", block_start, dep_b, index_test_log2_dep_b(block_start), (block_start % 2 != 0) ? -1 : 1);
+    mpfr_set_ui(dep_c, B, MPFR_RNDN);
+    mpfr_mul_ui(dep_c, dep_c, block_start, MPFR_RNDN);
+    mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
+    ok &= mpfr_index_test_check("MPFR Chudnovsky seed dep_c (n)", block_start, dep_c, index_test_log2_dep_c(block_start), 1);
+
+    //Chudnovsky: last term (with dep_a = 1)
+    n = num_chudnovsky - 1;
+    mpfr_set_ui(dep_a, 1, MPFR_RNDN);
+    mpfr_pow_ui(dep_b, c, n, MPFR_RNDN);
+    mpfr_set_ui(dep_c, B, MPFR_RNDN);
+    mpfr_mul_ui(dep_c, dep_c, n, MPFR_RNDN);
+    mpfr_add_ui(dep_c, dep_c, A, MPFR_RNDN);
+    mpfr_set_ui(term, 0, MPFR_RNDN);
+    mpfr_chudnovsky_iteration(term, n, dep_a, dep_b, dep_c, aux);
+    ok &= mpfr_index_test_check("MPFR Chudnovsky term (n)", n, term, index_test_log2_dep_c(n) - index_test_log2_dep_b(n), (n % 2 != 0) ? -1 : 1);
+
+    mpfr_clears(term, quotient, dep_m, dep_a, dep_b, dep_c, c, a, b, d, e, f, g, h, aux, NULL);
+    return ok;
+}
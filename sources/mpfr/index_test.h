@@ -0,0 +1,6 @@
+#ifndef MPFR_INDEX_TEST
+#define MPFR_INDEX_TEST
+
+int mpfr_index_test(long, long, long, int);
+
+#endif
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "parallel_multiplication.h"
+
+
+#define NEWTON_MIN_PRECISION 48         // Bits given by the double precision seed
+#define NEWTON_GUARD_BITS 64
+#define NEWTON_STEP_GUARD_BITS 16      // Keeps the bits lost by rounding from doubling at each step
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Newton based reciprocal, inverse square root, square root and division           *
+ * They are used to compute the final division of the Chudnovsky algorithms         *
+ *                                                                                  *
+ ************************************************************************************
+ * Newton iterations (the precision is doubled at each step):                       *
+ *                                                                                  *
+ *      reciprocal:           x(k+1) = x(k) + x(k) (1 - a x(k))                     *
+ *                                                                                  *
+ *      inverse sqrt:         y(k+1) = y(k) + y(k) (1 - a y(k)^2) / 2               *
+ *                                                                                  *
+ *      The last step of the square root and the division is done over the result   *
+ *      (Karp-Markstein), with the inverse computed to half of the precision        *
+ *                                                                                  *
+ * The products of the steps are performed with mpfr_parallel_mul, which uses all   *
+ * the threads for the big products                                                 *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Returns in precisions[] the precision (in bits) of each Newton step, 
+ * from the last one to the first one, and the number of steps
+ */
+int mpfr_newton_precisions(mpfr_prec_t * precisions, mpfr_prec_t target_precision){
+    int steps = 0;
+    mpfr_prec_t precision = target_precision + NEWTON_GUARD_BITS;
+
+    while(precision > NEWTON_MIN_PRECISION){
+        precisions[steps++] = precision;
+        precision = precision / 2 + NEWTON_STEP_GUARD_BITS;
+    }
+    return steps;
+}
+
+/*
+ * r = 1 / a
+ */
+void mpfr_newton_reciprocal(mpfr_t r, mpfr_t a){
+    int i, steps;
+    long exponent;
+    double seed;
+    mpfr_prec_t precisions[64];
+    mpfr_t x, t, a_rounded;
+
+    steps = mpfr_newton_precisions(precisions, mpfr_get_prec(r));
+
+    //Seed: a = seed * 2^exponent -> 1/a = (1/seed) * 2^(-exponent)
+    seed = mpfr_get_d_2exp(&exponent, a, MPFR_RNDN);
+    mpfr_inits2(NEWTON_MIN_PRECISION, x, t, a_rounded, NULL);
+    mpfr_set_d(x, 1.0 / seed, MPFR_RNDN);
+    mpfr_mul_2si(x, x, -exponent, MPFR_RNDN);
+
+    for(i = steps - 1; i >= 0; i--){
+        mpfr_prec_round(x, precisions[i], MPFR_RNDN);
+        mpfr_set_prec(t, precisions[i]);
+        mpfr_set_prec(a_rounded, precisions[i]);
+        mpfr_set(a_rounded, a, MPFR_RNDN);
+
+        mpfr_parallel_mul(t, a_rounded, x);       // t = a x
+        mpfr_ui_sub(t, 1, t, MPFR_RNDN);        // t = 1 - a x
+        mpfr_parallel_mul(t, x, t);               // t = x (1 - a x)
+        mpfr_add(x, x, t, MPFR_RNDN);
+    }
+    mpfr_set(r, x, MPFR_RNDN);
+
+    mpfr_clears(x, t, a_rounded, NULL);
+}
+
+/*
+ * r = 1 / sqrt(a), a > 0
+ */
+void mpfr_newton_inverse_sqrt(mpfr_t r, mpfr_t a){
+    int i, steps;
+    long exponent;
+    double seed;
+    mpfr_prec_t precisions[64];
+    mpfr_t y, t, a_rounded;
+
+    steps = mpfr_newton_precisions(precisions, mpfr_get_prec(r));
+
+    //Seed: a = seed * 2^exponent (exponent even) -> 1/sqrt(a) = (1/sqrt(seed)) * 2^(-exponent/2)
+    seed = mpfr_get_d_2exp(&exponent, a, MPFR_RNDN);
+    if(exponent % 2 != 0){
+        seed *= 2;
+        exponent--;
+    }
+    mpfr_inits2(NEWTON_MIN_PRECISION, y, t, a_rounded, NULL);
+    mpfr_set_d(y, 1.0 / sqrt(seed), MPFR_RNDN);
+    mpfr_mul_2si(y, y, -exponent / 2, MPFR_RNDN);
+
+    for(i = steps - 1; i >= 0; i--){
+        mpfr_prec_round(y, precisions[i], MPFR_RNDN);
+        mpfr_set_prec(t, precisions[i]);
+        mpfr_set_prec(a_rounded, precisions[i]);
+        mpfr_set(a_rounded, a, MPFR_RNDN);
+
+        mpfr_parallel_mul(t, y, y);               // t = y^2
+        mpfr_parallel_mul(t, a_rounded, t);       // t = a y^2
+        mpfr_ui_sub(t, 1, t, MPFR_RNDN);        // t = 1 - a y^2
+        mpfr_parallel_mul(t, y, t);               // t = y (1 - a y^2)
+        mpfr_div_2ui(t, t, 1, MPFR_RNDN);
+        mpfr_add(y, y, t, MPFR_RNDN);
+    }
+    mpfr_set(r, y, MPFR_RNDN);
+
+    mpfr_clears(y, t, a_rounded, NULL);
+}
+
+/*
+ * r = sqrt(a), a > 0. The inverse square root is only computed with half
+ * of the precision, the last step is done directly over the square root (Karp):
+ *      s = a y,   sqrt(a) = s + y (a - s^2) / 2
+ */
+void mpfr_newton_sqrt(mpfr_t r, mpfr_t a){
+    mpfr_prec_t half_precision;
+    mpfr_t y, s, t;
+
+    half_precision = mpfr_get_prec(r) / 2 + NEWTON_GUARD_BITS;
+    mpfr_inits2(half_precision, y, s, NULL);
+    mpfr_init2(t, mpfr_get_prec(r) + NEWTON_GUARD_BITS);
+
+    mpfr_newton_inverse_sqrt(y, a);
+    mpfr_parallel_mul(s, a, y);               // s = a y
+    mpfr_parallel_mul(t, s, s);               // t = s^2
+    mpfr_sub(t, a, t, MPFR_RNDN);           // t = a - s^2
+    mpfr_prec_round(t, half_precision, MPFR_RNDN);
+    mpfr_parallel_mul(t, y, t);               // t = y (a - s^2)
+    mpfr_div_2ui(t, t, 1, MPFR_RNDN);
+    mpfr_add(r, s, t, MPFR_RNDN);
+
+    mpfr_clears(y, s, t, NULL);
+}
+
+/*
+ * q = a / b. The reciprocal of b is only computed with half of the precision, 
+ * the last step is done directly over the quotient (Karp-Markstein):
+ *      q0 = a x,   q = q0 + x (a - b q0)
+ */
+void mpfr_newton_div(mpfr_t q, mpfr_t a, mpfr_t b){
+    mpfr_prec_t half_precision;
+    mpfr_t x, q0, t;
+
+    half_precision = mpfr_get_prec(q) / 2 + NEWTON_GUARD_BITS;
+    mpfr_inits2(half_precision, x, q0, NULL);
+    mpfr_init2(t, mpfr_get_prec(q) + NEWTON_GUARD_BITS);
+
+    mpfr_newton_reciprocal(x, b);
+    mpfr_parallel_mul(q0, a, x);              // q0 = a x
+    mpfr_parallel_mul(t, b, q0);              // t = b q0
+    mpfr_sub(t, a, t, MPFR_RNDN);           // t = a - b q0
+    mpfr_prec_round(t, half_precision, MPFR_RNDN);
+    mpfr_parallel_mul(t, x, t);               // t = x (a - b q0)
+    mpfr_add(q, q0, t, MPFR_RNDN);
+
+    mpfr_clears(x, q0, t, NULL);
+}
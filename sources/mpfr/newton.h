@@ -0,0 +1,9 @@
+#ifndef MPFR_NEWTON
+#define MPFR_NEWTON
+
+void mpfr_newton_reciprocal(mpfr_t, mpfr_t);
+void mpfr_newton_inverse_sqrt(mpfr_t, mpfr_t);
+void mpfr_newton_sqrt(mpfr_t, mpfr_t);
+void mpfr_newton_div(mpfr_t, mpfr_t, mpfr_t);
+
+#endif
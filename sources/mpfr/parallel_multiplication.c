@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../gmp/parallel_multiplication.h"
+
+
+#define PARALLEL_MUL_THRESHOLD 4096     // Limbs of the smallest operand
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Parallel multiplication of big operands (MPFR version)                           *
+ * The mantissas are multiplied with gmp_parallel_mpz_mul and the result is         *
+ * rounded to the precision of r                                                    *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * r = a * b using all the threads available when the operands are big enough
+ */
+void mpfr_parallel_mul(mpfr_t r, mpfr_t a, mpfr_t b){
+    mp_size_t a_size, b_size;
+    mpfr_exp_t exponent;
+    mpz_t a_mantissa, b_mantissa, product;
+
+    if(!mpfr_regular_p(a) || !mpfr_regular_p(b) || omp_in_parallel() || omp_get_max_threads() < 2){
+        mpfr_mul(r, a, b, MPFR_RNDN);
+        return;
+    }
+    a_size = (mpfr_get_prec(a) + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    b_size = (mpfr_get_prec(b) + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    if(a_size < PARALLEL_MUL_THRESHOLD || b_size < PARALLEL_MUL_THRESHOLD){
+        mpfr_mul(r, a, b, MPFR_RNDN);
+        return;
+    }
+
+    mpz_roinit_n(a_mantissa, a -> _mpfr_d, (mpfr_sgn(a) < 0) ? -a_size : a_size);
+    mpz_roinit_n(b_mantissa, b -> _mpfr_d, (mpfr_sgn(b) < 0) ? -b_size : b_size);
+    mpz_init(product);
+    gmp_parallel_mpz_mul(product, a_mantissa, (a == b) ? a_mantissa : b_mantissa);
+
+    //Value of the product = product * 2^(exponent)
+    exponent = mpfr_get_exp(a) + mpfr_get_exp(b) - (a_size + b_size) * GMP_NUMB_BITS;
+    mpfr_set_z_2exp(r, product, exponent, MPFR_RNDN);
+
+    mpz_clear(product);
+}
@@ -0,0 +1,6 @@
+#ifndef MPFR_PARALLEL_MULTIPLICATION
+#define MPFR_PARALLEL_MULTIPLICATION
+
+void mpfr_parallel_mul(mpfr_t, mpfr_t, mpfr_t);
+
+#endif
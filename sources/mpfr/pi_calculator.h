@@ -1,7 +1,7 @@
 #ifndef MPFR_PI_CALCULATOR
 #define MPFR_PI_CALCULATOR
 
-void mpfr_calculate_pi(int, int, int, bool);
+void mpfr_calculate_pi(int, long, int, bool);
 
 #endif
 
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include <mpfr.h>
+#include "../gmp/radix_conversion.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Binary to decimal conversion of pi (MPFR version of gmp/radix_conversion.c)      *
+ * The fraction of pi is taken as an integer and converted by the GMP remainder     *
+ * tree                                                                             *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * Takes the fraction of pi for decimals decimals (fraction = floor(frac(pi) 2^gmp_radix_fraction_bits))
+ * and returns the integer part
+ */
+unsigned long mpfr_radix_fraction(mpz_t fraction, mpfr_t pi, long decimals){
+    unsigned long integer_part;
+    mpfr_t float_fraction;
+
+    mpfr_init2(float_fraction, mpfr_get_prec(pi));
+    integer_part = mpfr_get_ui(pi, MPFR_RNDZ);
+    mpfr_frac(float_fraction, pi, MPFR_RNDZ);
+    mpfr_mul_2ui(float_fraction, float_fraction, gmp_radix_fraction_bits(decimals), MPFR_RNDZ);
+    mpfr_get_z(fraction, float_fraction, MPFR_RNDZ);
+    mpfr_clear(float_fraction);
+    return integer_part;
+}
+
+/*
+ * Writes pi with decimals decimals in the output file. It uses num_threads threads
+ */
+void mpfr_radix_write(mpfr_t pi, long decimals, int num_threads){
+    unsigned long integer_part;
+    mpz_t fraction;
+
+    mpz_init(fraction);
+    integer_part = mpfr_radix_fraction(fraction, pi, decimals);
+    gmp_radix_write_fraction(integer_part, fraction, decimals, num_threads);
+    mpz_clear(fraction);
+}
+
+/*
+ * Packs pi with decimals decimals in the packed file. It uses num_threads threads
+ */
+void mpfr_radix_pack(mpfr_t pi, char * algorithm_tag, long decimals, int num_threads){
+    unsigned long integer_part;
+    mpz_t fraction;
+
+    mpz_init(fraction);
+    integer_part = mpfr_radix_fraction(fraction, pi, decimals);
+    gmp_radix_pack_fraction(algorithm_tag, decimals, integer_part, fraction, decimals, num_threads);
+    mpz_clear(fraction);
+}
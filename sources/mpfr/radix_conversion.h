@@ -0,0 +1,8 @@
+#ifndef MPFR_RADIX_CONVERSION
+#define MPFR_RADIX_CONVERSION
+
+unsigned long mpfr_radix_fraction(mpz_t, mpfr_t, long);
+void mpfr_radix_write(mpfr_t, long, int);
+void mpfr_radix_pack(mpfr_t, char *, long, int);
+
+#endif
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpfr.h>
+#include <omp.h>
+#include "../common/numa.h"
+#include "../common/memory_allocator.h"
+#include "../common/phase_timers.h"
+
+
+/************************************************************************************
+ * 18/10/2026                                                                       *
+ * Pairwise (tree) reduction of the partial results computed by each thread         *
+ *                                                                                  *
+ ************************************************************************************
+ * Every thread publishes its local_pi in partials[thread_id]. Then, at each level  *
+ * of the tree, thread t adds partials[t + stride] into partials[t] when            *
+ * t % (2 * stride) == 0. With 8 threads the additions performed are:               *
+ *                                                                                  *
+ *      stride 1:   0 <- 1,   2 <- 3,   4 <- 5,   6 <- 7                            *
+ *      stride 2:   0 <- 2,   4 <- 6                                                *
+ *      stride 4:   0 <- 4                                                          *
+ *                                                                                  *
+ * The order of the additions only depends on the thread ids, so the result is the  *
+ * same bit by bit in every execution, and it needs log2(num_threads) steps.        *
+ *                                                                                  *
+ * In the NUMA mode the tree is built inside each node first and then among the     *
+ * first threads of the nodes, so each partial result crosses sockets only once.    *
+ *                                                                                  *
+ ************************************************************************************/
+
+/*
+ * This method must be called by all the threads of the parallel region
+ * (it contains barriers). partials must be a shared vector with, at least,
+ * num_threads positions. When it returns, pi = pi + sum(local_pi) 
+ */
+void mpfr_tree_reduction(mpfr_t pi, mpfr_t local_pi, mpfr_ptr * partials, int thread_id, int num_threads){
+    int stride, group, num_groups, first_thread, group_threads, group_thread_id;
+
+    num_groups = numa_num_groups(num_threads);
+    group = numa_thread_group(thread_id, num_threads);
+    first_thread = numa_group_first_thread(group, num_threads);
+    group_threads = ((group + 1 < num_groups) ? numa_group_first_thread(group + 1, num_threads) : num_threads) - first_thread;
+    group_thread_id = thread_id - first_thread;
+
+    memory_allocator_set_phase(ALLOCATOR_PHASE_REDUCTION);
+
+    //Tree inside each group (node). All the threads go through the same barriers
+    partials[thread_id] = local_pi;
+    for(stride = 1; stride < numa_max_group_size(num_threads); stride <<= 1){
+        phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+        #pragma omp barrier
+        phase_timers_lap(thread_id, TIMERS_PHASE_WAIT);
+        if((group_thread_id % (stride << 1) == 0) && (group_thread_id + stride < group_threads)){
+            mpfr_add(partials[thread_id], partials[thread_id], partials[thread_id + stride], MPFR_RNDN);
+        }
+    }
+
+    //Tree among the first threads of the groups
+    for(stride = 1; stride < num_groups; stride <<= 1){
+        phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+        #pragma omp barrier
+        phase_timers_lap(thread_id, TIMERS_PHASE_WAIT);
+        if((group_thread_id == 0) && (group % (stride << 1) == 0) && (group + stride < num_groups)){
+            mpfr_add(partials[thread_id], partials[thread_id], partials[numa_group_first_thread(group + stride, num_threads)], MPFR_RNDN);
+        }
+    }
+
+    //Wait until all the partials have been read before the threads clear them
+    phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+    #pragma omp barrier
+    phase_timers_lap(thread_id, TIMERS_PHASE_WAIT);
+    if(thread_id == 0){
+        mpfr_add(pi, pi, partials[0], MPFR_RNDN);
+    }
+    phase_timers_lap(thread_id, TIMERS_PHASE_REDUCTION);
+    memory_allocator_set_phase(ALLOCATOR_PHASE_FINAL);
+}
@@ -0,0 +1,6 @@
+#ifndef MPFR_REDUCTION
+#define MPFR_REDUCTION
+
+void mpfr_tree_reduction(mpfr_t, mpfr_t, mpfr_ptr *, int, int);
+
+#endif